@@ -71,13 +71,10 @@ TypeId Arbiter::GetTypeId (void)
 Arbiter::Arbiter(Ptr<Node> this_node, NodeContainer nodes) {
     m_node_id = this_node->GetId();
     m_nodes = nodes;
+    m_forwarding_state_epoch = 0;
 
-    // Store IP address to node id (each interface has an IP address, so multiple IPs per node)
-    for (uint32_t i = 0; i < m_nodes.GetN(); i++) {
-        for (uint32_t j = 1; j < m_nodes.Get(i)->GetObject<Ipv4>()->GetNInterfaces(); j++) {
-            m_ip_to_node_id.insert({m_nodes.Get(i)->GetObject<Ipv4>()->GetAddress(j, 0).GetLocal().Get(), i});
-        }
-    }
+    // IP address to node id (each interface has an IP address, so multiple IPs per node)
+    m_ip_to_node_id = IpToNodeIdResolver::GetShared(m_nodes);
 
 }
 
@@ -86,9 +83,9 @@ Arbiter::~Arbiter() {
 }
 
 uint32_t Arbiter::ResolveNodeIdFromIp(uint32_t ip) {
-    m_ip_to_node_id_it = m_ip_to_node_id.find(ip);
-    if (m_ip_to_node_id_it != m_ip_to_node_id.end()) {
-        return m_ip_to_node_id_it->second;
+    int64_t node_id = m_ip_to_node_id->Resolve(ip);
+    if (node_id != -1) {
+        return node_id;
     } else {
         std::ostringstream res;
         res << "IP address " << Ipv4Address(ip)  << " (" << ip << ") is not mapped to a node id";
@@ -96,6 +93,14 @@ uint32_t Arbiter::ResolveNodeIdFromIp(uint32_t ip) {
     }
 }
 
+uint64_t Arbiter::GetForwardingStateEpoch() {
+    return m_forwarding_state_epoch;
+}
+
+void Arbiter::NotifyForwardingStateChanged() {
+    m_forwarding_state_epoch++;
+}
+
 ArbiterResult Arbiter::BaseDecide(Ptr<const Packet> pkt, Ipv4Header const &ipHeader) {
 
     // Retrieve the source node id
@@ -24,6 +24,7 @@
 #include "ns3/topology.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-header.h"
+#include "ns3/ip-to-node-id-resolver.h"
 
 namespace ns3 {
 
@@ -113,13 +114,27 @@ public:
      */
     virtual std::string StringReprOfForwardingState() = 0;
 
+    /**
+     * Get the forwarding state epoch, which is incremented every time the forwarding state changes.
+     * It is used by ipv4-arbiter-routing to know when to invalidate its route cache.
+     *
+     * @return Forwarding state epoch
+     */
+    uint64_t GetForwardingStateEpoch();
+
 protected:
+
+    /**
+     * Called by a subclass whenever its forwarding state changes.
+     */
+    void NotifyForwardingStateChanged();
+
     int32_t m_node_id;
     ns3::NodeContainer m_nodes;
 
 private:
-    std::map<uint32_t, uint32_t> m_ip_to_node_id;
-    std::map<uint32_t, uint32_t>::iterator m_ip_to_node_id_it;
+    Ptr<IpToNodeIdResolver> m_ip_to_node_id;  // Shared by all arbiters of the same nodes
+    uint64_t m_forwarding_state_epoch;        // Incremented on every forwarding state change
 
 };
 
@@ -138,30 +138,21 @@ void BasicSimulation::ConfigureSimulation() {
             throw std::runtime_error(format_string("Systems count in configuration (%u) does not match up with MPI systems count (%u)", config_systems_count, m_systems_count));
         }
 
-        // Check node-to-system-id assignment
-        m_distributed_node_system_id_assignment = parse_list_positive_int64(GetConfigParamOrFail("distributed_node_system_id_assignment"));
-        std::vector<int> system_id_counter(m_systems_count, 0);
-        for (uint32_t i = 0; i < m_distributed_node_system_id_assignment.size(); i++) {
-            if (m_distributed_node_system_id_assignment.at(i) < 0 || m_distributed_node_system_id_assignment.at(i) >= m_systems_count) {
-                throw std::invalid_argument(format_string(
-                        "Node %d is assigned to an invalid system id %" PRId64 " (k=%" PRId64 ")",
-                        i,
-                        m_distributed_node_system_id_assignment.at(i),
-                        m_systems_count
-                ));
-            }
-            system_id_counter.at(m_distributed_node_system_id_assignment.at(i))++;
-        }
-
-        // All good, showing summary
-        printf("  > System information (%u systems):\n", GetSystemsCount());
-        for (uint32_t i = 0; i < m_systems_count; i++) {
-            printf("    >> System %d has %d node(s)\n", i, system_id_counter.at(i));
+        // Node-to-system-id assignment, either given or determined later by the topology
+        std::string assignment_str = GetConfigParamOrFail("distributed_node_system_id_assignment");
+        if (assignment_str == "auto") {
+            m_distributed_node_system_id_assignment_auto = true;
+            m_distributed_node_system_id_assignment.clear();
+            printf("  > Node-to-system-id assignment... auto (determined by the topology)\n");
+        } else {
+            m_distributed_node_system_id_assignment_auto = false;
+            SetDistributedNodeSystemIdAssignment(parse_list_positive_int64(assignment_str));
         }
 
     } else {
         printf("  > Distributed is not enabled\n");
         m_distributed_node_system_id_assignment.clear();
+        m_distributed_node_system_id_assignment_auto = false;
         m_system_id = 0;
         m_systems_count = 1;
     }
@@ -402,6 +393,41 @@ const std::vector<int64_t>& BasicSimulation::GetDistributedNodeSystemIdAssignmen
     return m_distributed_node_system_id_assignment;
 }
 
+bool BasicSimulation::IsDistributedNodeSystemIdAssignmentAuto() {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such the node assignment should not need to be determined");
+    }
+    return m_distributed_node_system_id_assignment_auto;
+}
+
+void BasicSimulation::SetDistributedNodeSystemIdAssignment(const std::vector<int64_t>& assignment) {
+    if (!m_enable_distributed) {
+        throw std::runtime_error("Distributed mode is not enabled, as such the node assignment should not need to be set");
+    }
+
+    // Check node-to-system-id assignment
+    std::vector<int> system_id_counter(m_systems_count, 0);
+    for (uint32_t i = 0; i < assignment.size(); i++) {
+        if (assignment.at(i) < 0 || assignment.at(i) >= m_systems_count) {
+            throw std::invalid_argument(format_string(
+                    "Node %d is assigned to an invalid system id %" PRId64 " (k=%" PRId64 ")",
+                    i,
+                    assignment.at(i),
+                    m_systems_count
+            ));
+        }
+        system_id_counter.at(assignment.at(i))++;
+    }
+    m_distributed_node_system_id_assignment = assignment;
+
+    // All good, showing summary
+    printf("  > System information (%u systems):\n", GetSystemsCount());
+    for (uint32_t i = 0; i < m_systems_count; i++) {
+        printf("    >> System %d has %d node(s)\n", i, system_id_counter.at(i));
+    }
+
+}
+
 int64_t BasicSimulation::GetSimulationEndTimeNs() {
     return m_simulation_end_time_ns;
 }
@@ -51,6 +51,8 @@ public:
     uint32_t GetSystemsCount();
     bool IsNodeAssignedToThisSystem(int64_t node_id);
     const std::vector<int64_t>& GetDistributedNodeSystemIdAssignment();
+    bool IsDistributedNodeSystemIdAssignmentAuto();
+    void SetDistributedNodeSystemIdAssignment(const std::vector<int64_t>& assignment);
     int64_t GetSimulationEndTimeNs();
     std::string GetConfigParamOrFail(std::string key);
     std::string GetConfigParamOrDefault(std::string key, std::string default_value);
@@ -91,6 +93,7 @@ private:
     uint32_t m_systems_count;
     bool m_enable_distributed;
     std::vector<int64_t> m_distributed_node_system_id_assignment;
+    bool m_distributed_node_system_id_assignment_auto; // True iff the topology determines the assignment
 
     // Progress show variables
     int64_t m_sim_start_time_ns_since_epoch;
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ip-to-node-id-resolver.h"
+
+#include <algorithm>
+#include <map>
+#include "ns3/ipv4.h"
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (IpToNodeIdResolver);
+TypeId IpToNodeIdResolver::GetTypeId (void)
+{
+    static TypeId tid = TypeId ("ns3::IpToNodeIdResolver")
+            .SetParent<Object> ()
+            .SetGroupName("BasicSim")
+    ;
+    return tid;
+}
+
+IpToNodeIdResolver::IpToNodeIdResolver(NodeContainer nodes) {
+    m_num_nodes = nodes.GetN();
+
+    // Each interface (except loop-back) has an IP address, so multiple IPs per node.
+    // If an IP address is on multiple nodes, the first one is used.
+    std::vector<std::pair<uint32_t, int32_t>> ip_node_ids;
+    for (uint32_t i = 0; i < nodes.GetN(); i++) {
+        Ptr<Ipv4> ipv4 = nodes.Get(i)->GetObject<Ipv4>();
+        for (uint32_t j = 1; j < ipv4->GetNInterfaces(); j++) {
+            ip_node_ids.push_back(std::make_pair(ipv4->GetAddress(j, 0).GetLocal().Get(), (int32_t) i));
+        }
+    }
+
+    // Highest host byte in use per subnet
+    std::map<uint32_t, uint32_t> subnet_max_host;
+    for (const std::pair<uint32_t, int32_t>& p : ip_node_ids) {
+        uint32_t& max_host = subnet_max_host[p.first >> 8];
+        max_host = std::max(max_host, p.first & 0xff);
+    }
+
+    // Directly index the subnets if they (mostly) follow each other up
+    m_first_subnet = 0;
+    m_num_subnets = 0;
+    if (!subnet_max_host.empty()) {
+        uint32_t span = subnet_max_host.rbegin()->first - subnet_max_host.begin()->first + 1;
+        if (span <= 2 * subnet_max_host.size() + 256) {
+            m_first_subnet = subnet_max_host.begin()->first;
+            m_num_subnets = span;
+        }
+    }
+    m_subnet_begin.assign(m_num_subnets + 1, 0);
+    for (const std::pair<const uint32_t, uint32_t>& p : subnet_max_host) {
+        if (m_num_subnets > 0) {
+            m_subnet_begin[p.first - m_first_subnet + 1] = p.second + 1;
+        }
+    }
+    for (uint32_t s = 0; s < m_num_subnets; s++) {
+        m_subnet_begin[s + 1] += m_subnet_begin[s];
+    }
+    m_node_ids.assign(m_subnet_begin[m_num_subnets], -1);
+
+    // Fill in
+    for (const std::pair<uint32_t, int32_t>& p : ip_node_ids) {
+        if (m_num_subnets > 0) {
+            int32_t& node_id = m_node_ids[m_subnet_begin[(p.first >> 8) - m_first_subnet] + (p.first & 0xff)];
+            if (node_id == -1) {
+                node_id = p.second;
+            }
+        } else {
+            m_sparse.insert(p);
+        }
+    }
+
+}
+
+Ptr<IpToNodeIdResolver> IpToNodeIdResolver::GetShared(NodeContainer nodes) {
+    if (nodes.GetN() == 0) {
+        return CreateObject<IpToNodeIdResolver>(nodes);
+    }
+
+    // Kept with the first node, such that it lives as long as the nodes do
+    Ptr<IpToNodeIdResolver> resolver = nodes.Get(0)->GetObject<IpToNodeIdResolver>();
+    if (resolver == 0) {
+        resolver = CreateObject<IpToNodeIdResolver>(nodes);
+        nodes.Get(0)->AggregateObject(resolver);
+    } else if (resolver->GetNumNodes() != nodes.GetN()) {
+        resolver = CreateObject<IpToNodeIdResolver>(nodes); // Different set of nodes, so not shared
+    }
+    return resolver;
+}
+
+uint32_t IpToNodeIdResolver::GetNumNodes() const {
+    return m_num_nodes;
+}
+
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IP_TO_NODE_ID_RESOLVER_H
+#define IP_TO_NODE_ID_RESOLVER_H
+
+#include <unordered_map>
+#include <vector>
+#include "ns3/object.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+
+/**
+ * Resolves the node id of an interface IP address, for all nodes at once.
+ *
+ * Topologies assign the interfaces sequentially from /24 subnets, as such the
+ * addresses are looked up directly by subnet index (the address without its
+ * last byte, relative to the first subnet) and then host byte in a contiguous
+ * array. Addresses which do not fit this (if the subnets are sparse), are kept
+ * in a hash map instead.
+ *
+ * A single resolver is shared by all arbiters of the same nodes (see GetShared).
+ */
+class IpToNodeIdResolver : public Object {
+
+public:
+    static TypeId GetTypeId(void);
+    IpToNodeIdResolver(NodeContainer nodes);
+
+    /**
+     * Get the resolver shared by all users of these nodes, which is created
+     * the first time (with the addresses the interfaces have at that moment).
+     *
+     * @param nodes    All nodes
+     *
+     * @return Shared resolver
+     */
+    static Ptr<IpToNodeIdResolver> GetShared(NodeContainer nodes);
+
+    /**
+     * Resolve the node identifier from an IP address.
+     *
+     * @param ip    IP address
+     *
+     * @return Node identifier, or -1 if no interface has the IP address
+     */
+    int64_t Resolve(uint32_t ip) const {
+        uint32_t subnet = (ip >> 8) - m_first_subnet; // Wraps around if below the first subnet
+        if (subnet < m_num_subnets) {
+            uint32_t index = m_subnet_begin[subnet] + (ip & 0xff);
+            return index < m_subnet_begin[subnet + 1] ? m_node_ids[index] : -1;
+        }
+        if (m_sparse.empty()) {
+            return -1;
+        }
+        std::unordered_map<uint32_t, int32_t>::const_iterator it = m_sparse.find(ip);
+        return it != m_sparse.end() ? it->second : -1;
+    }
+
+    uint32_t GetNumNodes() const;
+
+private:
+    uint32_t m_num_nodes;
+    uint32_t m_first_subnet;                        // First subnet index (IP address >> 8)
+    uint32_t m_num_subnets;                         // Number of consecutive subnets directly indexed
+    std::vector<uint32_t> m_subnet_begin;           // Subnet -> index of its host byte 0 in m_node_ids (one extra at the end)
+    std::vector<int32_t> m_node_ids;                // Node id per (subnet, host byte), -1 if none
+    std::unordered_map<uint32_t, int32_t> m_sparse; // IP address -> node id if the subnets are sparse
+
+};
+
+}
+
+#endif //IP_TO_NODE_ID_RESOLVER_H
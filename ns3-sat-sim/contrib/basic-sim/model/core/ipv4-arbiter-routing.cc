@@ -49,7 +49,7 @@ namespace ns3 {
         return tid;
     }
 
-    Ipv4ArbiterRouting::Ipv4ArbiterRouting() : m_ipv4(0) {
+    Ipv4ArbiterRouting::Ipv4ArbiterRouting() : m_ipv4(0), m_routeCacheEpoch(0) {
         NS_LOG_FUNCTION(this);
     }
 
@@ -96,12 +96,47 @@ namespace ns3 {
             return 0;
         }
 
-        // If it succeeded to find a next hop, extract the output interface index and gateway IP address
-        uint32_t if_idx = result.GetOutIfIdx();
-        uint32_t gateway_ip_address = result.GetGatewayIpAddress();
+        // If it succeeded to find a next hop, the route follows from the output interface index and gateway IP address
+        return GetCachedRoute(result.GetOutIfIdx(), result.GetGatewayIpAddress(), dest);
+
+    }
+
+    /**
+     * Get the route for an output interface, gateway and destination.
+     * The route is created only the first time it is requested, after which
+     * the same (immutable) route is handed out until the forwarding state
+     * of the arbiter changes.
+     *
+     * @param if_idx                Output interface index
+     * @param gateway_ip_address    Gateway IP address
+     * @param dest                  Destination IP address
+     *
+     * @return Ipv4 route
+     */
+    Ptr<Ipv4Route>
+    Ipv4ArbiterRouting::GetCachedRoute (uint32_t if_idx, uint32_t gateway_ip_address, const Ipv4Address& dest) {
+
+        // Invalidate all cached routes if the forwarding state has changed since
+        uint64_t epoch = m_arbiter->GetForwardingStateEpoch();
+        if (epoch != m_routeCacheEpoch) {
+            for (std::unordered_map<uint64_t, Ptr<Ipv4Route>>& routes : m_routeCache) {
+                routes.clear();
+            }
+            m_routeCacheEpoch = epoch;
+        }
+
+        // Cached route
+        if (if_idx >= m_routeCache.size()) {
+            m_routeCache.resize(m_ipv4->GetNInterfaces());
+        }
+        NS_ABORT_MSG_IF(if_idx >= m_routeCache.size(), "Output interface index " << if_idx << " does not exist");
+        Ptr<Ipv4Route>& rtentry = m_routeCache[if_idx][(((uint64_t) gateway_ip_address) << 32) | dest.Get()];
+        if (rtentry != 0) {
+            return rtentry;
+        }
 
         // Create routing entry
-        Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
+        rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(dest);
         rtentry->SetSource(m_ipv4->SourceAddressSelection(if_idx, dest)); // This is basically the IP of the interface
                                                                           // It is used by a transport layer to
@@ -288,6 +323,8 @@ namespace ns3 {
     void
     Ipv4ArbiterRouting::SetArbiter (Ptr<Arbiter> arbiter) {
         m_arbiter = arbiter;
+        m_routeCache.clear();
+        m_routeCacheEpoch = arbiter == 0 ? 0 : arbiter->GetForwardingStateEpoch();
     }
 
     Ptr<Arbiter>
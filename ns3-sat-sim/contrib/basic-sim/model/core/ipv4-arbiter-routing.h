@@ -22,6 +22,8 @@
 #ifndef IPV4_ARBITER_ROUTING_H
 #define IPV4_ARBITER_ROUTING_H
 
+#include <unordered_map>
+#include <vector>
 #include "ns3/net-device.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -106,12 +108,19 @@ virtual bool RouteInput(
 private:
     Ptr<Ipv4> m_ipv4;
     Ptr<Ipv4Route> LookupArbiter (const Ipv4Address& dest, const Ipv4Header &header, Ptr<const Packet> p, Ptr<NetDevice> oif = 0);
+    Ptr<Ipv4Route> GetCachedRoute (uint32_t if_idx, uint32_t gateway_ip_address, const Ipv4Address& dest);
     Ptr<Arbiter> m_arbiter = 0;
     Ipv4Address m_nodeSingleIpAddress;
     Ipv4Mask loopbackMask = Ipv4Mask("255.0.0.0");
     Ipv4Address loopbackIp = Ipv4Address("127.0.0.1");
     uint32_t m_nodeId;
 
+    // Route cache: for each output interface, (gateway IP << 32 | destination IP) -> route
+    // The routes are shared and must not be modified; the cache is emptied when the forwarding state epoch
+    // of the arbiter changes, such that routes which are no longer in use do not accumulate
+    std::vector<std::unordered_map<uint64_t, Ptr<Ipv4Route>>> m_routeCache;
+    uint64_t m_routeCacheEpoch;
+
 };
 
 } // Namespace ns3
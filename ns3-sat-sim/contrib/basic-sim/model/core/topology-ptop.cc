@@ -234,6 +234,9 @@ void TopologyPtop::ParseTopologyGraph() {
 
     // Check that each node has an assignment to a system id if it is distributed
     if (m_basicSimulation->IsDistributedEnabled()) {
+        if (m_basicSimulation->IsDistributedNodeSystemIdAssignmentAuto()) {
+            throw std::invalid_argument("Point-to-point topology does not support automatic node-to-system-id assignment");
+        }
         size_t node_assignment_size = m_basicSimulation->GetDistributedNodeSystemIdAssignment().size();
         if (node_assignment_size != (size_t) m_num_nodes) {
             throw std::invalid_argument(
@@ -8,6 +8,8 @@ using namespace ns3;
 #include "test-case-with-log-validators.h"
 
 #include "core/arbiter-test.h"
+#include "core/ip-to-node-id-resolver-test.h"
+#include "core/ipv4-arbiter-routing-route-cache-test.h"
 
 
 class BasicSimCoreArbiterTestSuite : public TestSuite {
@@ -26,6 +28,13 @@ public:
         AddTestCase(new ArbiterEcmpSeparatedTestCase, TestCase::QUICK);
         AddTestCase(new Ipv4ArbiterRoutingNoRouteTestCase, TestCase::QUICK);
 
+        // IP to node id resolver
+        AddTestCase(new IpToNodeIdResolverDenseTestCase, TestCase::QUICK);
+        AddTestCase(new IpToNodeIdResolverSparseTestCase, TestCase::QUICK);
+
+        // IPv4 arbiter routing route cache
+        AddTestCase(new Ipv4ArbiterRoutingRouteCacheTestCase, TestCase::QUICK);
+
     }
 };
 static BasicSimCoreArbiterTestSuite basicSimCoreArbiterTestSuite;
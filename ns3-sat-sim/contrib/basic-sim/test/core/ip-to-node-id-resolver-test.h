@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/internet-module.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/ip-to-node-id-resolver.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class IpToNodeIdResolverTestCase : public TestCase
+{
+public:
+    IpToNodeIdResolverTestCase (std::string s) : TestCase (s) {};
+
+    // Adds an interface with the IP address (in a /24 subnet) to the node
+    void AddInterface(Ptr<Node> node, std::string ip) {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        uint32_t if_id = ipv4->AddInterface(device);
+        ipv4->AddAddress(if_id, Ipv4InterfaceAddress(Ipv4Address(ip.c_str()), Ipv4Mask("255.255.255.0")));
+    }
+
+    int64_t Resolve(Ptr<IpToNodeIdResolver> resolver, std::string ip) {
+        return resolver->Resolve(Ipv4Address(ip.c_str()).Get());
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class IpToNodeIdResolverDenseTestCase : public IpToNodeIdResolverTestCase
+{
+public:
+    IpToNodeIdResolverDenseTestCase () : IpToNodeIdResolverTestCase ("ip-to-node-id-resolver dense") {};
+    void DoRun () {
+
+        // Consecutive subnets (10.0.3.0/24 is not used), as topologies assign them
+        NodeContainer nodes;
+        nodes.Create(3);
+        InternetStackHelper internet;
+        internet.Install(nodes);
+        AddInterface(nodes.Get(0), "10.0.0.1");
+        AddInterface(nodes.Get(0), "10.0.1.1");
+        AddInterface(nodes.Get(1), "10.0.0.2");
+        AddInterface(nodes.Get(1), "10.0.2.1");
+        AddInterface(nodes.Get(2), "10.0.1.2");
+        AddInterface(nodes.Get(2), "10.0.2.2");
+        AddInterface(nodes.Get(2), "10.0.4.1");
+        Ptr<IpToNodeIdResolver> resolver = CreateObject<IpToNodeIdResolver>(nodes);
+        ASSERT_EQUAL(resolver->GetNumNodes(), 3);
+
+        // Every interface address
+        ASSERT_EQUAL(Resolve(resolver, "10.0.0.1"), 0);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.1.1"), 0);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.0.2"), 1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.2.1"), 1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.1.2"), 2);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.2.2"), 2);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.4.1"), 2);
+
+        // Below the first subnet
+        ASSERT_EQUAL(Resolve(resolver, "9.255.255.1"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "0.0.0.0"), -1);
+
+        // Host byte not in use, or past the highest in use of its subnet
+        ASSERT_EQUAL(Resolve(resolver, "10.0.0.0"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.0.3"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.1.255"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.4.2"), -1);
+
+        // Unused subnet in between, and past the last subnet
+        ASSERT_EQUAL(Resolve(resolver, "10.0.3.1"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.5.1"), -1);
+
+        // Unknown
+        ASSERT_EQUAL(Resolve(resolver, "192.168.0.1"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "255.255.255.255"), -1);
+
+        // Shared for the same nodes, which are all nodes
+        ASSERT_TRUE(IpToNodeIdResolver::GetShared(nodes) == IpToNodeIdResolver::GetShared(nodes));
+        ASSERT_EQUAL(IpToNodeIdResolver::GetShared(nodes)->Resolve(Ipv4Address("10.0.2.2").Get()), 2);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class IpToNodeIdResolverSparseTestCase : public IpToNodeIdResolverTestCase
+{
+public:
+    IpToNodeIdResolverSparseTestCase () : IpToNodeIdResolverTestCase ("ip-to-node-id-resolver sparse") {};
+    void DoRun () {
+
+        // Subnets which are too far apart to directly index
+        NodeContainer nodes;
+        nodes.Create(3);
+        InternetStackHelper internet;
+        internet.Install(nodes);
+        AddInterface(nodes.Get(0), "10.0.0.1");
+        AddInterface(nodes.Get(1), "11.0.0.1");
+        AddInterface(nodes.Get(1), "11.0.0.2");
+        AddInterface(nodes.Get(2), "12.0.0.5");
+        Ptr<IpToNodeIdResolver> resolver = CreateObject<IpToNodeIdResolver>(nodes);
+
+        // Every interface address
+        ASSERT_EQUAL(Resolve(resolver, "10.0.0.1"), 0);
+        ASSERT_EQUAL(Resolve(resolver, "11.0.0.1"), 1);
+        ASSERT_EQUAL(Resolve(resolver, "11.0.0.2"), 1);
+        ASSERT_EQUAL(Resolve(resolver, "12.0.0.5"), 2);
+
+        // Below the first subnet, past the highest host byte, and unknown
+        ASSERT_EQUAL(Resolve(resolver, "9.0.0.1"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "12.0.0.6"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "12.0.0.4"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "10.0.1.1"), -1);
+        ASSERT_EQUAL(Resolve(resolver, "192.168.0.1"), -1);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
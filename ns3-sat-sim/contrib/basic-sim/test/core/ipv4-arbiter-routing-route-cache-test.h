@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Arbiter which sends everything to a single next hop, which can be changed the same
+// way as a forwarding state update does (e.g., SetSingleForwardState in satellite-network)
+class ArbiterSettableNextHop: public Arbiter
+{
+public:
+
+    ArbiterSettableNextHop(Ptr<Node> this_node, NodeContainer nodes) : Arbiter(this_node, nodes) {
+        m_out_if_idx = 0;
+        m_gateway_ip_address = 0;
+    }
+
+    ArbiterResult Decide(
+            int32_t source_node_id,
+            int32_t target_node_id,
+            ns3::Ptr<const ns3::Packet> pkt,
+            ns3::Ipv4Header const &ipHeader,
+            bool is_socket_request_for_source_ip
+    ) {
+        if (m_out_if_idx == 0) {
+            return ArbiterResult(true, 0, 0);
+        }
+        return ArbiterResult(false, m_out_if_idx, m_gateway_ip_address);
+    }
+
+    void SetNextHop(uint32_t out_if_idx, uint32_t gateway_ip_address) {
+        m_out_if_idx = out_if_idx;
+        m_gateway_ip_address = gateway_ip_address;
+        NotifyForwardingStateChanged();
+    }
+
+    std::string StringReprOfForwardingState() {
+        return "";
+    }
+
+private:
+    uint32_t m_out_if_idx;
+    uint32_t m_gateway_ip_address;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class Ipv4ArbiterRoutingRouteCacheTestCase : public TestCase
+{
+public:
+    Ipv4ArbiterRoutingRouteCacheTestCase () : TestCase ("ipv4-arbiter-routing route-cache") {};
+
+    Ptr<Ipv4Route> RouteOutput(Ptr<Ipv4ArbiterRouting> routing, std::string source, std::string destination) {
+        Ipv4Header ipHeader;
+        ipHeader.SetSource(Ipv4Address(source.c_str()));
+        ipHeader.SetDestination(Ipv4Address(destination.c_str()));
+        ipHeader.SetProtocol(17);
+        Socket::SocketErrno sockerr;
+        return routing->RouteOutput(Create<Packet>(100), ipHeader, 0, sockerr);
+    }
+
+    void DoRun () {
+
+        // Triangle: 0 -- 1 (10.0.0.0/24), 0 -- 2 (10.0.1.0/24), 1 -- 2 (10.0.2.0/24)
+        NodeContainer nodes;
+        nodes.Create(3);
+        InternetStackHelper internet;
+        internet.SetRoutingHelper(Ipv4ArbiterRoutingHelper());
+        internet.Install(nodes);
+        PointToPointHelper p2p;
+        Ipv4AddressHelper address;
+        address.SetBase("10.0.0.0", "255.255.255.0");
+        address.Assign(p2p.Install(nodes.Get(0), nodes.Get(1)));
+        address.NewNetwork();
+        address.Assign(p2p.Install(nodes.Get(0), nodes.Get(2)));
+        address.NewNetwork();
+        address.Assign(p2p.Install(nodes.Get(1), nodes.Get(2)));
+
+        // Arbiter of node 0, which first sends everything via node 1 (interface 1)
+        Ptr<Ipv4ArbiterRouting> routing = nodes.Get(0)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>();
+        Ptr<ArbiterSettableNextHop> arbiter = CreateObject<ArbiterSettableNextHop>(nodes.Get(0), nodes);
+        routing->SetArbiter(arbiter);
+        arbiter->SetNextHop(1, Ipv4Address("10.0.0.2").Get());
+
+        // Route towards node 2
+        Ptr<Ipv4Route> route_a = RouteOutput(routing, "10.0.0.1", "10.0.2.2");
+        ASSERT_TRUE(route_a != 0);
+        ASSERT_EQUAL(route_a->GetDestination(), Ipv4Address("10.0.2.2"));
+        ASSERT_EQUAL(route_a->GetGateway(), Ipv4Address("10.0.0.2"));
+        ASSERT_EQUAL(route_a->GetSource(), Ipv4Address("10.0.0.1"));
+        ASSERT_TRUE(route_a->GetOutputDevice() == nodes.Get(0)->GetObject<Ipv4>()->GetNetDevice(1));
+
+        // The same (interface, gateway, destination) is handed out as the same route,
+        // also if only the source differs (e.g., a socket request for its source IP)
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.2.2") == route_a);
+        ASSERT_TRUE(RouteOutput(routing, "10.0.1.1", "10.0.2.2") == route_a);
+        ASSERT_TRUE(RouteOutput(routing, "102.102.102.102", "10.0.2.2") == route_a);
+
+        // Another destination has its own route
+        Ptr<Ipv4Route> route_b = RouteOutput(routing, "10.0.0.1", "10.0.1.2");
+        ASSERT_TRUE(route_b != route_a);
+        ASSERT_EQUAL(route_b->GetDestination(), Ipv4Address("10.0.1.2"));
+        ASSERT_EQUAL(route_b->GetGateway(), Ipv4Address("10.0.0.2"));
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.1.2") == route_b);
+
+        // Forwarding state change: directly to node 2 (interface 2) instead
+        arbiter->SetNextHop(2, Ipv4Address("10.0.1.2").Get());
+        Ptr<Ipv4Route> route_c = RouteOutput(routing, "10.0.0.1", "10.0.2.2");
+        ASSERT_TRUE(route_c != route_a);
+        ASSERT_EQUAL(route_c->GetDestination(), Ipv4Address("10.0.2.2"));
+        ASSERT_EQUAL(route_c->GetGateway(), Ipv4Address("10.0.1.2"));
+        ASSERT_EQUAL(route_c->GetSource(), Ipv4Address("10.0.1.1"));
+        ASSERT_TRUE(route_c->GetOutputDevice() == nodes.Get(0)->GetObject<Ipv4>()->GetNetDevice(2));
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.2.2") == route_c);
+
+        // The routes are immutable, so the earlier ones are left as they were
+        ASSERT_EQUAL(route_a->GetGateway(), Ipv4Address("10.0.0.2"));
+        ASSERT_TRUE(route_a->GetOutputDevice() == nodes.Get(0)->GetObject<Ipv4>()->GetNetDevice(1));
+
+        // Back to the first next hop: the old entries are gone, so it is a new route
+        arbiter->SetNextHop(1, Ipv4Address("10.0.0.2").Get());
+        Ptr<Ipv4Route> route_d = RouteOutput(routing, "10.0.0.1", "10.0.2.2");
+        ASSERT_TRUE(route_d != route_a);
+        ASSERT_TRUE(route_d != route_c);
+        ASSERT_EQUAL(route_d->GetGateway(), Ipv4Address("10.0.0.2"));
+        ASSERT_TRUE(route_d->GetOutputDevice() == nodes.Get(0)->GetObject<Ipv4>()->GetNetDevice(1));
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.1.2") != route_b);
+
+        // Same for a change in gateway only (only the cache key matters here, not whether it is a neighbor)
+        arbiter->SetNextHop(1, Ipv4Address("10.0.0.1").Get());
+        Ptr<Ipv4Route> route_e = RouteOutput(routing, "10.0.0.1", "10.0.2.2");
+        ASSERT_TRUE(route_e != route_d);
+        ASSERT_EQUAL(route_e->GetGateway(), Ipv4Address("10.0.0.1"));
+
+        // Setting another arbiter empties the cache as well
+        Ptr<ArbiterSettableNextHop> other_arbiter = CreateObject<ArbiterSettableNextHop>(nodes.Get(0), nodes);
+        other_arbiter->SetNextHop(1, Ipv4Address("10.0.0.1").Get());
+        routing->SetArbiter(other_arbiter);
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.2.2") != route_e);
+
+        // A drop has no route
+        other_arbiter->SetNextHop(0, 0);
+        ASSERT_TRUE(RouteOutput(routing, "10.0.0.1", "10.0.2.2") == 0);
+
+        Simulator::Destroy();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,217 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/*
+ * Microbenchmark of one hop over the satellite network devices. It measures
+ * the wall-clock cost (ns/hop) of sending packets from one device to another
+ * (Send, queue, transmission, channel, Receive), over:
+ *
+ *  - a PointToPointLaserNetDevice pair (ISL)
+ *  - a GSLNetDevice pair (satellite to ground station)
+ *
+ * Every hop passes eight per-packet trace points (MacTx, PhyTxBegin, PhyTxEnd,
+ * Sniffer and PromiscSniffer on both ends, PhyRxEnd). To isolate their cost,
+ * it also measures the invocation of an empty TracedCallback.
+ *
+ * Build it once normally and once with -DNS3_SATNET_TRACE_FREE=ON: the
+ * difference in ns/hop is what compiling out the trace points saves. The
+ * results are written as CSV:
+ *   trace_free,operation,num_ops,total_ns,ns_per_op
+ *
+ * Usage: ./ns3 run "satellite-network-device-bench --packets=1000000
+ *                   --output=bench.csv"
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/data-rate.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/satnet-trace.h"
+#include "ns3/simulator.h"
+#include "ns3/traced-callback.h"
+
+using namespace ns3;
+
+namespace {
+
+#ifdef NS3_SATNET_TRACE_FREE
+const bool TraceFree = true;
+#else
+const bool TraceFree = false;
+#endif
+
+/// Number of packets received over all devices
+uint64_t g_received = 0;
+
+/**
+ * Receive callback of the receiving device.
+ *
+ * @return true
+ */
+bool
+Receive (Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address &)
+{
+  g_received++;
+  return true;
+}
+
+/**
+ * Write a measurement.
+ *
+ * @param os       Output
+ * @param name     Name of the operation
+ * @param numOps   Number of operations
+ * @param totalNs  Total wall-clock time (ns)
+ */
+void
+Write (std::ostream &os, const std::string &name, uint64_t numOps, int64_t totalNs)
+{
+  os << (TraceFree ? "true" : "false") << "," << name << "," << numOps << "," << totalNs << ","
+     << (double) totalNs / numOps << std::endl;
+}
+
+/**
+ * Create two nodes, 1000 km apart, which do not move.
+ *
+ * @return the nodes
+ */
+NodeContainer
+CreateNodes (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (i * 1000000.0, 0.0, 7000000.0));
+      nodes.Get (i)->AggregateObject (mobility);
+    }
+  return nodes;
+}
+
+/**
+ * Time sending packets from the first device to the second, two packets at
+ * once every microsecond: the first is transmitted right away, the second
+ * goes through the queue.
+ *
+ * @param os          Output
+ * @param name        Name of the operation
+ * @param devices     The sending and the receiving device
+ * @param numPackets  Number of packets
+ * @param packetSize  Packet size (byte)
+ */
+void
+RunHops (std::ostream &os, const std::string &name, const NetDeviceContainer &devices,
+         uint32_t numPackets, uint32_t packetSize)
+{
+  Ptr<NetDevice> src = devices.Get (0);
+  Ptr<NetDevice> dst = devices.Get (1);
+  dst->SetReceiveCallback (MakeCallback (&Receive));
+  Address dstAddress = dst->GetAddress ();
+
+  for (uint32_t k = 0; k < numPackets; k++)
+    {
+      Simulator::Schedule (NanoSeconds ((k / 2) * 1000), [src, dstAddress, packetSize] () {
+        src->Send (Create<Packet> (packetSize), dstAddress, 0x0800);
+      });
+    }
+
+  g_received = 0;
+  std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+  Simulator::Destroy ();
+  NS_ABORT_MSG_UNLESS (g_received == numPackets, "Only " << g_received << " of " << numPackets << " packets arrived");
+
+  Write (os, name, numPackets, std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count ());
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::string output = "";
+  uint32_t numPackets = 1000000;
+  uint32_t packetSize = 1500;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("packets", "Number of packets (hops) per device type", numPackets);
+  cmd.AddValue ("size", "Packet size (byte)", packetSize);
+  cmd.AddValue ("output", "CSV output file (empty for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  std::ofstream ofs;
+  if (!output.empty ())
+    {
+      ofs.open (output.c_str ());
+      NS_ABORT_MSG_UNLESS (ofs.is_open (), "Output file " << output << " could not be opened");
+    }
+  std::ostream &os = output.empty () ? std::cout : ofs;
+  os << "trace_free,operation,num_ops,total_ns,ns_per_op" << std::endl;
+
+  // Fast enough such that two packets are sent well within the interval between them
+  DataRate rate ("100Gbps");
+
+  // ISL
+  {
+    NodeContainer nodes = CreateNodes ();
+    PointToPointLaserHelper helper;
+    helper.SetQueue ("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue (QueueSize ("100p")));
+    helper.SetDeviceAttribute ("DataRate", DataRateValue (rate));
+    RunHops (os, "PointToPointLaserNetDevice hop", helper.Install (nodes), numPackets, packetSize);
+  }
+
+  // GSL
+  {
+    NodeContainer nodes = CreateNodes ();
+    NodeContainer satellites (nodes.Get (0));
+    NodeContainer groundStations (nodes.Get (1));
+    std::vector<std::tuple<int32_t, double> > nodeGslIfInfo (2, std::make_tuple (1, rate.GetBitRate () / 1e6));
+    GSLHelper helper;
+    helper.SetQueue ("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue (QueueSize ("100p")));
+    helper.SetDeviceAttribute ("DataRate", DataRateValue (rate));
+    RunHops (os, "GSLNetDevice hop", helper.Install (satellites, groundStations, nodeGslIfInfo), numPackets, packetSize);
+  }
+
+  // What a single trace point costs without sinks
+  {
+    TracedCallback<Ptr<const Packet> > trace;
+    Ptr<const Packet> packet = Create<Packet> (packetSize);
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+    for (uint32_t k = 0; k < numPackets; k++)
+      trace (packet);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+    Write (os, "TracedCallback (no sinks)", numPackets, std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count ());
+  }
+
+  return 0;
+}
@@ -19,30 +19,56 @@
 
 #include "arbiter-single-forward-helper.h"
 
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
 namespace ns3 {
 
-ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes) {
+static std::set<int64_t> AllNodeIds(NodeContainer nodes) {
+    std::set<int64_t> node_ids;
+    for (size_t i = 0; i < nodes.GetN(); i++) {
+        node_ids.insert(i);
+    }
+    return node_ids;
+}
+
+ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes)
+        : ArbiterSingleForwardHelper(basicSimulation, nodes, AllNodeIds(nodes)) {
+    // Every node is a destination
+}
+
+ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, const std::set<int64_t>& destinations) {
     std::cout << "SETUP SINGLE FORWARDING ROUTING" << std::endl;
     m_basicSimulation = basicSimulation;
     m_nodes = nodes;
 
     // Read in initial forwarding state
     std::cout << "  > Create initial single forwarding state" << std::endl;
-    std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> initial_forwarding_state = InitialEmptyForwardingState();
+    m_forwardingTable = InitialEmptyForwardingState(destinations);
+    std::cout << "  > Forwarding table of " << m_nodes.GetN() << " nodes x " << destinations.size() << " destinations ("
+              << m_forwardingTable->GetSizeByte() / 1000000.0 << " MB)" << std::endl;
     basicSimulation->RegisterTimestamp("Create initial single forwarding state");
 
     // Set the routing arbiters
     std::cout << "  > Setting the routing arbiter on each node" << std::endl;
     for (size_t i = 0; i < m_nodes.GetN(); i++) {
-        Ptr<ArbiterSingleForward> arbiter = CreateObject<ArbiterSingleForward>(m_nodes.Get(i), m_nodes, initial_forwarding_state[i]);
+        Ptr<ArbiterSingleForward> arbiter = CreateObject<ArbiterSingleForward>(m_nodes.Get(i), m_nodes, m_forwardingTable);
         m_arbiters.push_back(arbiter);
         m_nodes.Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->SetArbiter(arbiter);
     }
     basicSimulation->RegisterTimestamp("Setup routing arbiter on each node");
 
+    // Interfaces which forwarding state can refer to
+    std::cout << "  > Retrieve the interface kinds of each node" << std::endl;
+    InitialInterfaces();
+    basicSimulation->RegisterTimestamp("Retrieve interface kinds");
+
     // Load first forwarding state
     m_dynamicStateUpdateIntervalNs = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("dynamic_state_update_interval_ns"));
     std::cout << "  > Forward state update interval: " << m_dynamicStateUpdateIntervalNs << "ns" << std::endl;
+    m_routesBinary = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_routes_binary", "false"));
+    std::cout << "  > Forward state file format: " << (m_routesBinary ? "binary" : "text") << std::endl;
     std::cout << "  > Perform first forwarding state load for t=0" << std::endl;
     UpdateForwardingState(0);
     basicSimulation->RegisterTimestamp("Create initial single forwarding state");
@@ -50,17 +76,30 @@ ArbiterSingleForwardHelper::ArbiterSingleForwardHelper (Ptr<BasicSimulation> bas
     std::cout << std::endl;
 }
 
-std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>>
-ArbiterSingleForwardHelper::InitialEmptyForwardingState() {
-    std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> initial_forwarding_state;
-    for (size_t i = 0; i < m_nodes.GetN(); i++) {
-        std::vector <std::tuple<int32_t, int32_t, int32_t>> next_hop_list;
-        for (size_t j = 0; j < m_nodes.GetN(); j++) {
-            next_hop_list.push_back(std::make_tuple(-2, -2, -2)); // -2 indicates an invalid entry
+Ptr<SingleForwardTable>
+ArbiterSingleForwardHelper::InitialEmptyForwardingState(const std::set<int64_t>& destinations) {
+    return Create<SingleForwardTable>(m_nodes.GetN(), destinations);
+}
+
+void ArbiterSingleForwardHelper::InitialInterfaces() {
+    m_interfaces.resize(m_nodes.GetN());
+    for (size_t node_id = 0; node_id < m_nodes.GetN(); node_id++) {
+        Ptr<Ipv4> ipv4 = m_nodes.Get(node_id)->GetObject<Ipv4>();
+        for (uint32_t i = 1; i < ipv4->GetNInterfaces(); i++) { // Skip the loop-back interface
+            ForwardInterface interface = {false, false, -1, -1};
+            Ptr<NetDevice> device = ipv4->GetNetDevice(i);
+            interface.is_gsl = device->GetObject<GSLNetDevice>() != 0;
+            interface.is_isl = device->GetObject<PointToPointLaserNetDevice>() != 0;
+            if (interface.is_isl) {
+                Ptr<NetDevice> device0 = device->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(0);
+                Ptr<NetDevice> device1 = device->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(1);
+                Ptr<NetDevice> other_device = device0->GetNode()->GetId() == node_id ? device1 : device0;
+                interface.isl_peer_node_id = other_device->GetNode()->GetId();
+                interface.isl_peer_if_id = ((int64_t) other_device->GetIfIndex()) - 1;
+            }
+            m_interfaces[node_id].push_back(interface);
         }
-        initial_forwarding_state.push_back(next_hop_list);
     }
-    return initial_forwarding_state;
 }
 
 void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
@@ -68,7 +107,7 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
     // Filename
     std::ostringstream res;
     res << m_basicSimulation->GetRunDir() << "/";
-    res << m_basicSimulation->GetConfigParamOrFail("satellite_network_routes_dir") << "/fstate_" << t << ".txt";
+    res << m_basicSimulation->GetConfigParamOrFail("satellite_network_routes_dir") << "/fstate_" << t << (m_routesBinary ? ".bin" : ".txt");
     std::string filename = res.str();
 
     // Check that the file exists
@@ -76,84 +115,50 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
         throw std::runtime_error(format_string("File %s does not exist.", filename.c_str()));
     }
 
+    // Read in the forwarding state changes
+    if (m_routesBinary) {
+        ReadBinaryForwardingState(filename);
+    } else {
+        ReadTextForwardingState(filename);
+    }
+
+    // Given that this code will only be used with satellite networks, this is okay-ish,
+    // but it does create a very tight coupling between the two -- technically this class
+    // can be used for other purposes as well
+    if (!parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"))) {
+
+        // Plan the next update
+        int64_t next_update_ns = t + m_dynamicStateUpdateIntervalNs;
+        if (next_update_ns < m_basicSimulation->GetSimulationEndTimeNs()) {
+            Simulator::Schedule(NanoSeconds(m_dynamicStateUpdateIntervalNs), &ArbiterSingleForwardHelper::UpdateForwardingState, this, next_update_ns);
+        }
+
+    }
+
+}
+
+void ArbiterSingleForwardHelper::ReadTextForwardingState(const std::string& filename) {
+
     // Open file
     std::string line;
     std::ifstream fstate_file(filename);
     if (fstate_file) {
 
         // Go over each line
-        size_t line_counter = 0;
         while (getline(fstate_file, line)) {
 
             // Split on ,
             std::vector<std::string> comma_split = split_string(line, ",", 5);
 
-            // Retrieve identifiers
-            int64_t current_node_id = parse_positive_int64(comma_split[0]);
-            int64_t target_node_id = parse_positive_int64(comma_split[1]);
-            int64_t next_hop_node_id = parse_int64(comma_split[2]);
-            int64_t my_if_id = parse_int64(comma_split[3]);
-            int64_t next_if_id = parse_int64(comma_split[4]);
-
-            // Check the node identifiers
-            NS_ABORT_MSG_IF(current_node_id < 0 || current_node_id >= m_nodes.GetN(), "Invalid current node id.");
-            NS_ABORT_MSG_IF(target_node_id < 0 || target_node_id >= m_nodes.GetN(), "Invalid target node id.");
-            NS_ABORT_MSG_IF(next_hop_node_id < -1 || next_hop_node_id >= m_nodes.GetN(), "Invalid next hop node id.");
-
-            // Drops are only valid if all three values are -1
-            NS_ABORT_MSG_IF(
-                    !(next_hop_node_id == -1 && my_if_id == -1 && next_if_id == -1)
-                    &&
-                    !(next_hop_node_id != -1 && my_if_id != -1 && next_if_id != -1),
-                    "All three must be -1 for it to signify a drop."
-            );
-
-            // Check the interfaces exist
-            NS_ABORT_MSG_UNLESS(my_if_id == -1 || (my_if_id >= 0 && my_if_id + 1 < m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNInterfaces()), "Invalid current interface");
-            NS_ABORT_MSG_UNLESS(next_if_id == -1 || (next_if_id >= 0 && next_if_id + 1 < m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNInterfaces()), "Invalid next hop interface");
-
-            // Node id and interface id checks are only necessary for non-drops
-            if (next_hop_node_id != -1 && my_if_id != -1 && next_if_id != -1) {
-
-                // It must be either GSL or ISL
-                bool source_is_gsl = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<GSLNetDevice>() != 0;
-                bool source_is_isl = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>() != 0;
-                NS_ABORT_MSG_IF((!source_is_gsl) && (!source_is_isl), "Only GSL and ISL network devices are supported");
-
-                // If current is a GSL interface, the destination must also be a GSL interface
-                NS_ABORT_MSG_IF(
-                    source_is_gsl &&
-                    m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + next_if_id)->GetObject<GSLNetDevice>() == 0,
-                    "Destination interface must be attached to a GSL network device"
-                );
-
-                // If current is a p2p laser interface, the destination must match exactly its counter-part
-                NS_ABORT_MSG_IF(
-                    source_is_isl &&
-                    m_nodes.Get(next_hop_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + next_if_id)->GetObject<PointToPointLaserNetDevice>() == 0,
-                    "Destination interface must be an ISL network device"
-                );
-                if (source_is_isl) {
-                    Ptr<NetDevice> device0 = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(0);
-                    Ptr<NetDevice> device1 = m_nodes.Get(current_node_id)->GetObject<Ipv4>()->GetNetDevice(1 + my_if_id)->GetObject<PointToPointLaserNetDevice>()->GetChannel()->GetDevice(1);
-                    Ptr<NetDevice> other_device = device0->GetNode()->GetId() == current_node_id ? device1 : device0;
-                    NS_ABORT_MSG_IF(other_device->GetNode()->GetId() != next_hop_node_id, "Next hop node id across does not match");
-                    NS_ABORT_MSG_IF(other_device->GetIfIndex() != 1 + next_if_id, "Next hop interface id across does not match");
-                }
-
-            }
-
             // Add to forwarding state
-            m_arbiters.at(current_node_id)->SetSingleForwardState(
-                    target_node_id,
-                    next_hop_node_id,
-                    1 + my_if_id,   // Skip the loop-back interface
-                    1 + next_if_id  // Skip the loop-back interface
+            SetForwardingState(
+                    parse_positive_int64(comma_split[0]),
+                    parse_positive_int64(comma_split[1]),
+                    parse_int64(comma_split[2]),
+                    parse_int64(comma_split[3]),
+                    parse_int64(comma_split[4])
             );
 
-            // Next line
-            line_counter++;
-
         }
 
         // Close file
@@ -163,19 +168,107 @@ void ArbiterSingleForwardHelper::UpdateForwardingState(int64_t t) {
         throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
     }
 
-    // Given that this code will only be used with satellite networks, this is okay-ish,
-    // but it does create a very tight coupling between the two -- technically this class
-    // can be used for other purposes as well
-    if (!parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"))) {
+}
 
-        // Plan the next update
-        int64_t next_update_ns = t + m_dynamicStateUpdateIntervalNs;
-        if (next_update_ns < m_basicSimulation->GetSimulationEndTimeNs()) {
-            Simulator::Schedule(NanoSeconds(m_dynamicStateUpdateIntervalNs), &ArbiterSingleForwardHelper::UpdateForwardingState, this, next_update_ns);
+void ArbiterSingleForwardHelper::ReadBinaryForwardingState(const std::string& filename) {
+
+    // Open file
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error(format_string("File %s could not be read.", filename.c_str()));
+    }
+
+    // Header
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t values_per_record = 0;
+    uint64_t num_records = 0;
+    bool header_read = fread(magic, 1, 8, file) == 8
+                       && fread(&version, sizeof(uint32_t), 1, file) == 1
+                       && fread(&values_per_record, sizeof(uint32_t), 1, file) == 1
+                       && fread(&num_records, sizeof(uint64_t), 1, file) == 1;
+    if (!header_read || memcmp(magic, "SATFSTAT", 8) != 0 || version != 1 || values_per_record != 5) {
+        fclose(file);
+        throw std::runtime_error(format_string("File %s is not a version 1 binary forwarding state file.", filename.c_str()));
+    }
+
+    // The records must fill the rest of the file exactly, which is checked against
+    // the file size before allocating (such that the header cannot cause a huge allocation)
+    const uint64_t record_size_byte = 5 * sizeof(int32_t);
+    long header_end = ftell(file);
+    long file_end = -1;
+    if (header_end >= 0 && fseek(file, 0, SEEK_END) == 0) {
+        file_end = ftell(file);
+    }
+    if (file_end < header_end || fseek(file, header_end, SEEK_SET) != 0
+        || (uint64_t) (file_end - header_end) % record_size_byte != 0
+        || (uint64_t) (file_end - header_end) / record_size_byte != num_records) {
+        fclose(file);
+        throw std::runtime_error(format_string("File %s does not contain exactly %" PRIu64 " records.", filename.c_str(), num_records));
+    }
+
+    // All records at once
+    std::vector<int32_t> records(num_records * 5);
+    size_t num_read = fread(records.data(), sizeof(int32_t), records.size(), file);
+    fclose(file);
+    if (num_read != records.size()) {
+        throw std::runtime_error(format_string("File %s does not contain exactly %" PRIu64 " records.", filename.c_str(), num_records));
+    }
+
+    // Add to forwarding state
+    for (size_t i = 0; i < records.size(); i += 5) {
+        SetForwardingState(records[i], records[i + 1], records[i + 2], records[i + 3], records[i + 4]);
+    }
+
+}
+
+void ArbiterSingleForwardHelper::SetForwardingState(int64_t current_node_id, int64_t target_node_id, int64_t next_hop_node_id, int64_t my_if_id, int64_t next_if_id) {
+
+    // Check the node identifiers
+    NS_ABORT_MSG_IF(current_node_id < 0 || current_node_id >= m_nodes.GetN(), "Invalid current node id.");
+    NS_ABORT_MSG_IF(target_node_id < 0 || target_node_id >= m_nodes.GetN(), "Invalid target node id.");
+    NS_ABORT_MSG_IF(next_hop_node_id < -1 || next_hop_node_id >= m_nodes.GetN(), "Invalid next hop node id.");
+
+    // Drops are only valid if all three values are -1
+    NS_ABORT_MSG_IF(
+            !(next_hop_node_id == -1 && my_if_id == -1 && next_if_id == -1)
+            &&
+            !(next_hop_node_id != -1 && my_if_id != -1 && next_if_id != -1),
+            "All three must be -1 for it to signify a drop."
+    );
+
+    // Check the interfaces exist
+    NS_ABORT_MSG_UNLESS(my_if_id == -1 || (my_if_id >= 0 && my_if_id < (int64_t) m_interfaces[current_node_id].size()), "Invalid current interface");
+    NS_ABORT_MSG_UNLESS(next_if_id == -1 || (next_if_id >= 0 && next_if_id < (int64_t) m_interfaces[next_hop_node_id].size()), "Invalid next hop interface");
+
+    // Node id and interface id checks are only necessary for non-drops
+    if (next_hop_node_id != -1) {
+        const ForwardInterface& source = m_interfaces[current_node_id][my_if_id];
+        const ForwardInterface& destination = m_interfaces[next_hop_node_id][next_if_id];
+
+        // It must be either GSL or ISL
+        NS_ABORT_MSG_IF((!source.is_gsl) && (!source.is_isl), "Only GSL and ISL network devices are supported");
+
+        // If current is a GSL interface, the destination must also be a GSL interface
+        NS_ABORT_MSG_IF(source.is_gsl && !destination.is_gsl, "Destination interface must be attached to a GSL network device");
+
+        // If current is a p2p laser interface, the destination must match exactly its counter-part
+        NS_ABORT_MSG_IF(source.is_isl && !destination.is_isl, "Destination interface must be an ISL network device");
+        if (source.is_isl) {
+            NS_ABORT_MSG_IF(source.isl_peer_node_id != next_hop_node_id, "Next hop node id across does not match");
+            NS_ABORT_MSG_IF(source.isl_peer_if_id != next_if_id, "Next hop interface id across does not match");
         }
 
     }
 
+    // Add to forwarding state
+    m_arbiters.at(current_node_id)->SetSingleForwardState(
+            target_node_id,
+            next_hop_node_id,
+            1 + my_if_id,   // Skip the loop-back interface
+            1 + next_if_id  // Skip the loop-back interface
+    );
+
 }
 
 } // namespace ns3
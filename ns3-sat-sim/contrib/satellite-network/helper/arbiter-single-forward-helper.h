@@ -29,19 +29,58 @@
 
 namespace ns3 {
 
+    /**
+     * Installs the single forward arbiters and updates their forwarding state every
+     * dynamic_state_update_interval_ns from the fstate_<t> files in the
+     * satellite_network_routes_dir. Each line of a text file fstate_<t>.txt is:
+     *
+     *   <current node id>,<target node id>,<next hop node id>,<my if id>,<next if id>
+     *
+     * If satellite_network_routes_binary is true, the binary fstate_<t>.bin files are
+     * read instead (converted from the text files by satgenpy's convert_fstate_to_binary).
+     * File format (all values little-endian):
+     *
+     *   offset  size         content
+     *   0       8            magic "SATFSTAT"
+     *   8       4            format version (uint32, currently 1)
+     *   12      4            values per record (uint32, 5)
+     *   16      8            number of records R (uint64)
+     *   24      4*5*R        records (int32), in the same order as the text columns
+     *
+     * The kind (GSL or ISL) of every interface and the peer of every ISL interface
+     * are retrieved once at construction, such that the records of an update are
+     * validated with table lookups only.
+     */
     class ArbiterSingleForwardHelper
     {
     public:
         ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes);
+        ArbiterSingleForwardHelper(Ptr<BasicSimulation> basicSimulation, NodeContainer nodes, const std::set<int64_t>& destinations);
     private:
-        std::vector<std::vector<std::tuple<int32_t, int32_t, int32_t>>> InitialEmptyForwardingState();
+
+        // Interface of a node (excluding the loop-back interface)
+        struct ForwardInterface {
+            bool is_gsl;
+            bool is_isl;
+            int64_t isl_peer_node_id;  // Only for ISL: the node across
+            int64_t isl_peer_if_id;    // Only for ISL: the interface across (excluding loop-back)
+        };
+
+        Ptr<SingleForwardTable> InitialEmptyForwardingState(const std::set<int64_t>& destinations);
+        void InitialInterfaces();
         void UpdateForwardingState(int64_t t);
+        void ReadTextForwardingState(const std::string& filename);
+        void ReadBinaryForwardingState(const std::string& filename);
+        void SetForwardingState(int64_t current_node_id, int64_t target_node_id, int64_t next_hop_node_id, int64_t my_if_id, int64_t next_if_id);
 
         // Parameters
         Ptr<BasicSimulation> m_basicSimulation;
         NodeContainer m_nodes;
         int64_t m_dynamicStateUpdateIntervalNs;
         std::vector<Ptr<ArbiterSingleForward>> m_arbiters;
+        Ptr<SingleForwardTable> m_forwardingTable;
+        std::vector<std::vector<ForwardInterface>> m_interfaces;  // [node][if id]
+        bool m_routesBinary;
 
     };
 
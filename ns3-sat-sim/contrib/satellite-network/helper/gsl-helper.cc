@@ -113,11 +113,10 @@ GSLHelper::Install (NodeContainer satellites, NodeContainer ground_stations, std
 
     }
 
-    // The lower bound for the GSL channel must be set to facilitate distributed simulation.
-    // However, this is challenging, as delays vary over time based on the movement.
-    // As such, for now this delay = lookahead time is set to 0.
-    // (see also the Delay attribute in gsl-channel.cc)
-    channel->SetAttribute("Delay", TimeValue(Seconds(0)));
+    // The lower bound for the GSL channel (its Delay attribute) must be set to facilitate
+    // distributed simulation. As delays vary over time based on the movement, it must be
+    // derived from the orbits (see TopologySatelliteNetwork), as such it is left to
+    // SetChannelAttribute (and is 0 by default).
 
     return allNetDevices;
 }
@@ -45,6 +45,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("PointToPointLaserHelper");
 
 PointToPointLaserHelper::PointToPointLaserHelper ()
+  : m_lookaheadEnd (Seconds (0)),
+    m_lookaheadInterval (Seconds (1))
 {
   m_queueFactory.SetTypeId ("ns3::DropTailQueue<Packet>");
   m_deviceFactory.SetTypeId ("ns3::PointToPointLaserNetDevice");
@@ -81,6 +83,14 @@ PointToPointLaserHelper::SetChannelAttribute (std::string n1, const AttributeVal
   m_remoteChannelFactory.Set (n1, v1);
 }
 
+void
+PointToPointLaserHelper::SetLookaheadWindow (Time end, Time interval)
+{
+  NS_ABORT_MSG_UNLESS (interval.IsStrictlyPositive (), "Lookahead sample interval must be positive");
+  m_lookaheadEnd = end;
+  m_lookaheadInterval = interval;
+}
+
 NetDeviceContainer 
 PointToPointLaserHelper::Install (NodeContainer c)
 {
@@ -91,8 +101,8 @@ PointToPointLaserHelper::Install (NodeContainer c)
 NetDeviceContainer 
 PointToPointLaserHelper::Install (Ptr<Node> a, Ptr<Node> b)
 {
-  // set the initial delay of the channel as the delay estimation for the lookahead of the
-  // distributed scheduler
+  // set the initial delay of the channel as its delay estimation (for an ISL between two
+  // systems, it is replaced below by a lower bound, which is the lookahead)
   Ptr<MobilityModel> aMobility = a->GetObject<MobilityModel>();
   Ptr<MobilityModel> bMobility = b->GetObject<MobilityModel>();
   double propagation_speed(299792458.0);
@@ -123,39 +133,29 @@ PointToPointLaserHelper::Install (Ptr<Node> a, Ptr<Node> b)
   ndqiB->GetTxQueue (0)->ConnectQueueTraces (queueB);
   devB->AggregateObject (ndqiB);
 
-  // Distributed mode
-  NS_ABORT_MSG_IF(MpiInterface::IsEnabled(), "Distributed mode is not currently supported for point-to-point lasers.");
-
-  // Distributed mode is not currently supported, enable the below if it is:
-//  // If MPI is enabled, we need to see if both nodes have the same system id
-//  // (rank), and the rank is the same as this instance.  If both are true,
-//  //use a normal p2p channel, otherwise use a remote channel
-//  bool useNormalChannel = true;
-//  Ptr<PointToPointLaserChannel> channel = 0;
-//
-//  if (MpiInterface::IsEnabled ()) {
-//      uint32_t n1SystemId = a->GetSystemId ();
-//      uint32_t n2SystemId = b->GetSystemId ();
-//      uint32_t currSystemId = MpiInterface::GetSystemId ();
-//      if (n1SystemId != currSystemId || n2SystemId != currSystemId) {
-//          useNormalChannel = false;
-//      }
-//  }
-//  if (useNormalChannel) {
-//    channel = m_channelFactory.Create<PointToPointLaserChannel> ();
-//  }
-//  else {
-//    channel = m_remoteChannelFactory.Create<PointToPointLaserRemoteChannel>();
-//    Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
-//    Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
-//    mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devA));
-//    mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devB));
-//    devA->AggregateObject (mpiRecA);
-//    devB->AggregateObject (mpiRecB);
-//  }
-
-  // Create and attach channel
-  Ptr<PointToPointLaserChannel> channel = m_channelFactory.Create<PointToPointLaserChannel> ();
+  // If MPI is enabled and the two nodes are in different systems, use a remote channel.
+  // As the ISL length changes over time, its lower bound delay (which is the lookahead)
+  // is the smallest delay the two satellites can have over the lookahead window.
+  Ptr<PointToPointLaserChannel> channel = 0;
+  if (MpiInterface::IsEnabled () && a->GetSystemId () != b->GetSystemId ()) {
+    channel = m_remoteChannelFactory.Create<PointToPointLaserRemoteChannel> ();
+    Time lookahead = channel->GetMinDelay (aMobility, bMobility, m_lookaheadEnd, m_lookaheadInterval);
+    NS_ABORT_MSG_UNLESS (
+            lookahead.IsStrictlyPositive (),
+            "No positive lookahead for the ISL between node " << a->GetId () << " and " << b->GetId ()
+    );
+    channel->SetAttribute ("Delay", TimeValue (lookahead));
+    Ptr<MpiReceiver> mpiRecA = CreateObject<MpiReceiver> ();
+    Ptr<MpiReceiver> mpiRecB = CreateObject<MpiReceiver> ();
+    mpiRecA->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devA));
+    mpiRecB->SetReceiveCallback (MakeCallback (&PointToPointLaserNetDevice::Receive, devB));
+    devA->AggregateObject (mpiRecA);
+    devB->AggregateObject (mpiRecB);
+  } else {
+    channel = m_channelFactory.Create<PointToPointLaserChannel> ();
+  }
+
+  // Attach channel
   devA->Attach (channel);
   devB->Attach (channel);
   container.Add (devA);
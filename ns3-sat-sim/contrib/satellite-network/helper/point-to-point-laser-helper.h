@@ -30,6 +30,7 @@
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
 #include "ns3/trace-helper.h"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 
@@ -52,6 +53,10 @@ public:
   void SetDeviceAttribute (std::string name, const AttributeValue &value);
   void SetChannelAttribute (std::string name, const AttributeValue &value);
 
+  // Time span over which the lookahead of ISLs between systems must hold,
+  // and the interval at which their delay is sampled to determine it
+  void SetLookaheadWindow (Time end, Time interval);
+
   // Installers
   NetDeviceContainer Install (NodeContainer c);
   NetDeviceContainer Install (Ptr<Node> a, Ptr<Node> b);
@@ -61,6 +66,8 @@ private:
   ObjectFactory m_channelFactory;       //!< Channel Factory
   ObjectFactory m_remoteChannelFactory; //!< Remote Channel Factory
   ObjectFactory m_deviceFactory;        //!< Device Factory
+  Time m_lookaheadEnd;                  //!< End of the span over which the lookahead must hold
+  Time m_lookaheadInterval;             //!< Interval at which the delay is sampled for the lookahead
 };
 
 } // namespace ns3
@@ -34,10 +34,34 @@ TypeId ArbiterSingleForward::GetTypeId (void)
 ArbiterSingleForward::ArbiterSingleForward(
         Ptr<Node> this_node,
         NodeContainer nodes,
-        std::vector<std::tuple<int32_t, int32_t, int32_t>> next_hop_list
+        Ptr<SingleForwardTable> forwarding_table
 ) : ArbiterSatnet(this_node, nodes)
 {
-    m_next_hop_list = next_hop_list;
+    m_forwarding_table = forwarding_table;
+    m_next_hop_list = forwarding_table->GetRow(m_node_id);
+    m_gateway_list = forwarding_table->GetGatewayRow(m_node_id);
+}
+
+ArbiterResult ArbiterSingleForward::Decide(
+        int32_t source_node_id,
+        int32_t target_node_id,
+        Ptr<const Packet> pkt,
+        Ipv4Header const &ipHeader,
+        bool is_socket_request_for_source_ip
+) {
+
+    // Entry of the target node
+    int32_t column = m_forwarding_table->GetColumn(target_node_id);
+    NS_ABORT_MSG_IF(column == -1 || m_next_hop_list[column].next_node_id == -2, "Forwarding state is not set for this node to this target node (invalid).");
+    const SingleForwardEntry& entry = m_next_hop_list[column];
+
+    // Check whether it is a drop or not
+    if (entry.next_node_id != -1) {
+        return ArbiterResult(false, entry.own_if_id, m_gateway_list[column]);
+    } else {
+        return ArbiterResult(true, 0, 0); // Failed = no route (means either drop, or socket fails)
+    }
+
 }
 
 std::tuple<int32_t, int32_t, int32_t> ArbiterSingleForward::TopologySatelliteNetworkDecide(
@@ -47,21 +71,40 @@ std::tuple<int32_t, int32_t, int32_t> ArbiterSingleForward::TopologySatelliteNet
         Ipv4Header const &ipHeader,
         bool is_request_for_source_ip_so_no_next_header
 ) {
-    return m_next_hop_list[target_node_id];
+    int32_t column = m_forwarding_table->GetColumn(target_node_id);
+    if (column == -1) {
+        return std::make_tuple(-2, -2, -2); // Not a destination, so never set (invalid)
+    }
+    const SingleForwardEntry& entry = m_next_hop_list[column];
+    return std::make_tuple(entry.next_node_id, entry.own_if_id, entry.next_if_id);
 }
 
 void ArbiterSingleForward::SetSingleForwardState(int32_t target_node_id, int32_t next_node_id, int32_t own_if_id, int32_t next_if_id) {
     NS_ABORT_MSG_IF(next_node_id == -2 || own_if_id == -2 || next_if_id == -2, "Not permitted to set invalid (-2).");
-    m_next_hop_list[target_node_id] = std::make_tuple(next_node_id, own_if_id, next_if_id);
+    NS_ABORT_MSG_IF(own_if_id > INT16_MAX || next_if_id > INT16_MAX, "Interface id does not fit in the forwarding table.");
+    int32_t column = m_forwarding_table->GetColumn(target_node_id);
+    if (column == -1) {
+        throw std::invalid_argument("Target node " + std::to_string(target_node_id) + " is not a destination of the forwarding table.");
+    }
+    m_next_hop_list[column] = {next_node_id, (int16_t) own_if_id, (int16_t) next_if_id};
+
+    // The IP gateway only changes with the forwarding state, so it is retrieved once here
+    if (next_node_id != -1) {
+        m_gateway_list[column] = m_nodes.Get(next_node_id)->GetObject<Ipv4>()->GetAddress(next_if_id, 0).GetLocal().Get();
+    } else {
+        m_gateway_list[column] = 0;
+    }
+    NotifyForwardingStateChanged();
 }
 
 std::string ArbiterSingleForward::StringReprOfForwardingState() {
     std::ostringstream res;
     res << "Single-forward state of node " << m_node_id << std::endl;
-    for (size_t i = 0; i < m_nodes.GetN(); i++) {
-        res << "  -> " << i << ": (" << std::get<0>(m_next_hop_list[i]) << ", "
-            << std::get<1>(m_next_hop_list[i]) << ", "
-            << std::get<2>(m_next_hop_list[i]) << ")" << std::endl;
+    const std::vector<int64_t>& destinations = m_forwarding_table->GetDestinations();
+    for (size_t i = 0; i < destinations.size(); i++) {
+        res << "  -> " << destinations[i] << ": (" << m_next_hop_list[i].next_node_id << ", "
+            << m_next_hop_list[i].own_if_id << ", "
+            << m_next_hop_list[i].next_if_id << ")" << std::endl;
     }
     return res.str();
 }
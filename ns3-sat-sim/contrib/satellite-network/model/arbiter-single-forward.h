@@ -22,6 +22,7 @@
 
 #include <tuple>
 #include "ns3/arbiter-satnet.h"
+#include "ns3/single-forward-table.h"
 #include "ns3/topology-satellite-network.h"
 #include "ns3/hash.h"
 #include "ns3/abort.h"
@@ -36,11 +37,21 @@ class ArbiterSingleForward : public ArbiterSatnet
 public:
     static TypeId GetTypeId (void);
 
-    // Constructor for single forward next-hop forwarding state
+    // Constructor for single forward next-hop forwarding state, which is the
+    // row of this node in the forwarding table shared by all arbiters
     ArbiterSingleForward(
             Ptr<Node> this_node,
             NodeContainer nodes,
-            std::vector<std::tuple<int32_t, int32_t, int32_t>> next_hop_list
+            Ptr<SingleForwardTable> forwarding_table
+    );
+
+    // Single forward decision, directly from the forwarding table
+    ArbiterResult Decide(
+            int32_t source_node_id,
+            int32_t target_node_id,
+            ns3::Ptr<const ns3::Packet> pkt,
+            ns3::Ipv4Header const &ipHeader,
+            bool is_socket_request_for_source_ip
     );
 
     // Single forward next-hop implementation
@@ -59,7 +70,9 @@ public:
     std::string StringReprOfForwardingState();
 
 private:
-    std::vector<std::tuple<int32_t, int32_t, int32_t>> m_next_hop_list;
+    Ptr<SingleForwardTable> m_forwarding_table;
+    SingleForwardEntry* m_next_hop_list;  // Row of this node in the forwarding table
+    uint32_t* m_gateway_list;             // Gateway IPv4 address of each entry in the row
 
 };
 
@@ -42,7 +42,7 @@ GSLChannel::GetTypeId (void)
     .SetGroupName ("GSL")
     .AddConstructor<GSLChannel> ()
     .AddAttribute ("Delay",
-                   "The lower-bound propagation delay through the channel (it is accessed by the distributed simulator to determine lookahead time)",
+                   "The lower-bound propagation delay through the channel (it is the lookahead time of the distributed simulator)",
                    TimeValue (Seconds (0)),
                    MakeTimeAccessor (&GSLChannel::m_lowerBoundDelay),
                    MakeTimeChecker ())
@@ -51,13 +51,29 @@ GSLChannel::GetTypeId (void)
                    DoubleValue (299792458.0), // Default is speed of light
                    MakeDoubleAccessor (&GSLChannel::m_propagationSpeedMetersPerSecond),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayCacheQuantum",
+                   "Time quantum in which the delay between a pair of devices is computed once and reused (0 to compute it for every packet)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&GSLChannel::m_delayCacheQuantum),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("ZeroCopy",
+                   "Hand the transmitted packet itself to the receiving device instead of a copy "
+                   "(only if it arrives after the interframe gap of the transmitting device, which uses the "
+                   "packet until then; else it is still copied)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&GSLChannel::m_zeroCopy),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 GSLChannel::GSLChannel()
   :
-    Channel ()
+    Channel (),
+    m_zeroCopy (false),
+    m_mac_base (0),
+    m_delayCacheHits (0),
+    m_delayCacheMisses (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -72,69 +88,134 @@ GSLChannel::TransmitStart (
   NS_LOG_FUNCTION (this << p << src);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
 
-  Mac48Address address48 = Mac48Address::ConvertFrom (dst_address);
-  MacToNetDeviceI it = m_link.find (address48);
-  if (it != m_link.end ()) {
-    Ptr<GSLNetDevice> dst = it->second;
-    bool sameSystem = (src->GetNode()->GetSystemId() == dst->GetNode()->GetSystemId());
-    return TransmitTo(p, src, it->second, txTime, sameSystem);
-  }
-
-  NS_ABORT_MSG("MAC address could not be mapped to a network device.");
-  return false;
+  uint32_t srcIndex = GetDeviceIndex (Mac48Address::ConvertFrom (src->GetAddress ()));
+  uint32_t dstIndex = GetDeviceIndex (Mac48Address::ConvertFrom (dst_address));
+  return TransmitTo(p, srcIndex, dstIndex, txTime);
 }
 
 bool
-GSLChannel::TransmitTo(Ptr<const Packet> p, Ptr<GSLNetDevice> srcNetDevice, Ptr<GSLNetDevice> destNetDevice, Time txTime, bool isSameSystem) {
+GSLChannel::TransmitTo(Ptr<const Packet> p, uint32_t srcIndex, uint32_t dstIndex, Time txTime) {
 
-  // Mobility models for source and destination
-  Ptr<MobilityModel> senderMobility = srcNetDevice->GetNode()->GetObject<MobilityModel>();
+  const Ptr<GSLNetDevice>& srcNetDevice = m_net_devices[srcIndex];
+  const Ptr<GSLNetDevice>& destNetDevice = m_net_devices[dstIndex];
+  bool isSameSystem = m_net_device_system_ids[srcIndex] == m_net_device_system_ids[dstIndex];
   Ptr<Node> receiverNode = destNetDevice->GetNode();
-  Ptr<MobilityModel> receiverMobility = receiverNode->GetObject<MobilityModel>();
 
-  // Calculate delay
-  Time delay = this->GetDelay(senderMobility, receiverMobility);
+  // Entries computed with another quantum (i.e., it was changed during the run) are stale
+  if (m_delayCacheQuantum != m_delayCacheEntriesQuantum) {
+    m_delayCache.clear();
+    m_delayCacheEntriesQuantum = m_delayCacheQuantum;
+  }
+
+  // Calculate delay (or reuse it if it was already calculated within this quantum)
+  Time delay;
+  if (m_delayCacheQuantum.IsStrictlyPositive()) {
+    int64_t quantum = Simulator::Now().GetNanoSeconds() / m_delayCacheQuantum.GetNanoSeconds();
+    DelayCacheEntry& entry = m_delayCache[((uint64_t) srcIndex << 32) | dstIndex];
+    if (entry.quantum == quantum) {
+      m_delayCacheHits++;
+    } else {
+      m_delayCacheMisses++;
+      entry.delay = this->GetDelay(srcNetDevice->GetNode()->GetObject<MobilityModel>(), receiverNode->GetObject<MobilityModel>());
+      entry.quantum = quantum;
+    }
+    delay = entry.delay;
+  } else {
+    delay = this->GetDelay(srcNetDevice->GetNode()->GetObject<MobilityModel>(), receiverNode->GetObject<MobilityModel>());
+  }
   NS_LOG_DEBUG(
           "Sending packet " << p << " from node " << srcNetDevice->GetNode()->GetId()
           << " to " << destNetDevice->GetNode()->GetId() << " with delay " << delay
   );
 
-  // Distributed mode is not enabled
-  NS_ABORT_MSG_UNLESS(isSameSystem, "MPI distributed mode is currently not supported by the GSL channel.");
+  if (isSameSystem) {
 
-  // Schedule arrival of packet at destination network device
-  Simulator::ScheduleWithContext(
-          receiverNode->GetId(),
-          txTime + delay,
-          &GSLNetDevice::Receive,
-          destNetDevice,
-          p->Copy ()
-  );
+    // The transmitting device uses the packet until its interframe gap after the transmission
+    // has passed, so it can only be handed over itself if the receiver gets it no earlier
+    bool zeroCopy = m_zeroCopy && delay >= srcNetDevice->GetInterframeGap();
 
-  // Re-enabled below code if distributed is again enabled:
-  //  if (isSameSystem) {
-  //
-  //  } else {
-  //#ifdef NS3_MPI
-  //    Time rxTime = Simulator::Now () + txTime + delay;
-  //    MpiInterface::SendPacket (p->Copy (), rxTime, destNetDevice->GetNode()->GetId (), destNetDevice->GetIfIndex());
-  //#else
-  //    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
-  //#endif
-  //  }
+    // Schedule arrival of packet at destination network device
+    Simulator::ScheduleWithContext(
+            receiverNode->GetId(),
+            txTime + delay,
+            &GSLNetDevice::Receive,
+            destNetDevice,
+            zeroCopy ? ConstCast<Packet> (p) : p->Copy ()
+    );
+
+  } else {
+#ifdef NS3_MPI
+    // The lower bound is the lookahead of the distributed simulator: arriving any earlier
+    // at another system would violate causality
+    NS_ABORT_MSG_IF(
+            txTime + delay < m_lowerBoundDelay,
+            "GSL delay " << delay << " from node " << srcNetDevice->GetNode()->GetId() << " to "
+            << receiverNode->GetId() << " is below the lower bound " << m_lowerBoundDelay
+    );
+
+    // The packet is serialized immediately, as such it need not be copied
+    Time rxTime = Simulator::Now () + txTime + delay;
+    MpiInterface::SendPacket (ConstCast<Packet> (p), rxTime, receiverNode->GetId (), destNetDevice->GetIfIndex ());
+#else
+    NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+  }
 
   return true;
 }
 
-void
+uint32_t
 GSLChannel::Attach (Ptr<GSLNetDevice> device)
 {
     NS_LOG_FUNCTION (this << device);
     NS_ABORT_MSG_IF (device == 0, "Cannot add zero pointer network device.");
 
-    Mac48Address address48 = Mac48Address::ConvertFrom (device->GetAddress());
-    m_link[address48] = device;
+    uint32_t index = m_net_devices.size();
     m_net_devices.push_back(device);
+    m_net_device_system_ids.push_back(device->GetNode()->GetSystemId());
+
+    // Map the MAC address to the index, directly if it is within (or just after) the dense range
+    uint64_t mac = MacToInteger (Mac48Address::ConvertFrom (device->GetAddress()));
+    if (index == 0) {
+        m_mac_base = mac;
+    }
+    if (mac >= m_mac_base && mac - m_mac_base <= 2 * (uint64_t) m_mac_offset_to_index.size() + 1024) {
+        uint64_t offset = mac - m_mac_base;
+        if (offset >= m_mac_offset_to_index.size()) {
+            m_mac_offset_to_index.resize(offset + 1, -1);
+        }
+        m_mac_offset_to_index[offset] = index;
+    } else {
+        m_link[Mac48Address::ConvertFrom (device->GetAddress())] = index;
+    }
+    return index;
+}
+
+uint32_t
+GSLChannel::GetDeviceIndex (Mac48Address address) const
+{
+    uint64_t mac = MacToInteger (address);
+    if (mac >= m_mac_base && mac - m_mac_base < m_mac_offset_to_index.size()) {
+        int64_t index = m_mac_offset_to_index[mac - m_mac_base];
+        if (index >= 0) {
+            return index;
+        }
+    }
+    MacToNetDeviceI it = m_link.find (address);
+    NS_ABORT_MSG_IF(it == m_link.end (), "MAC address could not be mapped to a network device.");
+    return it->second;
+}
+
+uint64_t
+GSLChannel::MacToInteger (Mac48Address address)
+{
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t value = 0;
+    for (size_t i = 0; i < 6; i++) {
+        value = (value << 8) | buffer[i];
+    }
+    return value;
 }
 
 Time
@@ -161,6 +242,18 @@ size_t Mac48AddressHash::operator() (Mac48Address const &x) const
     return host;
 }
 
+uint64_t
+GSLChannel::GetDelayCacheHits (void) const
+{
+    return m_delayCacheHits;
+}
+
+uint64_t
+GSLChannel::GetDelayCacheMisses (void) const
+{
+    return m_delayCacheMisses;
+}
+
 std::size_t
 GSLChannel::GetNDevices (void) const
 {
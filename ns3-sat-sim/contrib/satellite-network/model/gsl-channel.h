@@ -29,6 +29,8 @@
 #include "ns3/mobility-model.h"
 //#include "ns3/sgi-hashmap.h"
 #include "ns3/mac48-address.h"
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -40,6 +42,7 @@ class Mac48AddressHash : public std::unary_function<Mac48Address, size_t> {
         size_t operator() (Mac48Address const &x) const;
 };
 
+
 class GSLChannel : public Channel 
 {
 public:
@@ -55,35 +58,59 @@ public:
   );
   bool TransmitTo(
           Ptr<const Packet> p,
-          Ptr<GSLNetDevice> srcNetDevice,
-          Ptr<GSLNetDevice> dstNetDevice,
-          Time txTime,
-          bool isSameSystem
+          uint32_t srcIndex,
+          uint32_t dstIndex,
+          Time txTime
   );
 
   // Device management
-  void Attach (Ptr<GSLNetDevice> device);
+  uint32_t Attach (Ptr<GSLNetDevice> device);
+  uint32_t GetDeviceIndex (Mac48Address address) const;
   virtual std::size_t GetNDevices (void) const;
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  // Delay cache statistics
+  uint64_t GetDelayCacheHits (void) const;
+  uint64_t GetDelayCacheMisses (void) const;
+
 protected:
   Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
+  static uint64_t MacToInteger (Mac48Address address);
 
   Time   m_lowerBoundDelay;                   //!< Propagation delay which is
                                               //   used to give a minimum lookahead time to the
-                                              //   distributed simulator (if it were enabled).
-                                              //   See also: distributed-simulator-impl.cc (line 173 onwards)
+                                              //   distributed simulator (packets to other systems
+                                              //   may never arrive earlier than that)
 
   double m_propagationSpeedMetersPerSecond;   //!< Propagation speed on the channel (used to live calculate the delay
                                               //   for each packet which is sent over this channel.
 
-  // Mac address to net device
-//   typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash> MacToNetDevice;
-//   typedef sgi::hash_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash>::iterator MacToNetDeviceI;
-  typedef std::unordered_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash> MacToNetDevice;
-  typedef std::unordered_map<Mac48Address, Ptr<GSLNetDevice>, Mac48AddressHash>::iterator MacToNetDeviceI;
-  MacToNetDevice m_link;
+  bool m_zeroCopy;                            //!< Pass the packet itself (not a copy) to the receiver if it arrives after the interframe gap
+
+  // Network devices, indexed by the order in which they were attached
   std::vector<Ptr<GSLNetDevice>> m_net_devices;
+  std::vector<uint32_t> m_net_device_system_ids;  //!< System id of the node of each device
+
+  // MAC address to device index: the helper allocates the MAC addresses of all devices
+  // one after the other, such that they are (mostly) a dense range starting at m_mac_base,
+  // which is looked up directly. Any address outside of that range is kept in m_link.
+  typedef std::unordered_map<Mac48Address, uint32_t, Mac48AddressHash> MacToNetDevice;
+  typedef std::unordered_map<Mac48Address, uint32_t, Mac48AddressHash>::const_iterator MacToNetDeviceI;
+  MacToNetDevice m_link;
+  uint64_t m_mac_base;
+  std::vector<int64_t> m_mac_offset_to_index;     //!< Device index of MAC address m_mac_base + offset (-1 if none)
+
+  // Delay per (source, destination) device index pair, reused within the same quantum
+  struct DelayCacheEntry {
+      DelayCacheEntry() : quantum(-1) {}
+      int64_t quantum;                        //!< Quantum in which the delay was computed
+      Time delay;                             //!< Propagation delay
+  };
+  Time m_delayCacheQuantum;                   //!< Quantum of the delay cache (0 = no caching)
+  Time m_delayCacheEntriesQuantum;            //!< Quantum with which the cached entries were computed
+  std::unordered_map<uint64_t, DelayCacheEntry> m_delayCache;  //!< Key: (source index << 32) | destination index
+  uint64_t m_delayCacheHits;
+  uint64_t m_delayCacheMisses;
 
 };
 
@@ -21,6 +21,8 @@
  */
 
 
+#include <algorithm>
+
 #include "ns3/log.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -182,6 +184,9 @@ GSLNetDevice::GSLNetDevice ()
   :
     m_txMachineState (READY),
     m_channel (0),
+    m_channelIndex (0),
+    m_queueDestsHead (0),
+    m_queueDestsCount (0),
     m_linkUp (false),
     m_currentPkt (0)
 {
@@ -221,9 +226,9 @@ GSLNetDevice::DoDispose ()
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
   m_queue = 0;
-  while (!m_queueDests.empty()) {
-      m_queueDests.pop();
-  }
+  m_queueDests.clear ();
+  m_queueDestsHead = 0;
+  m_queueDestsCount = 0;
   NetDevice::DoDispose ();
 }
 
@@ -241,8 +246,15 @@ GSLNetDevice::SetInterframeGap (Time t)
   m_tInterframeGap = t;
 }
 
+Time
+GSLNetDevice::GetInterframeGap (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_tInterframeGap;
+}
+
 bool
-GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
+GSLNetDevice::TransmitStart (Ptr<Packet> p, uint32_t destIndex)
 {
   NS_LOG_FUNCTION (this << p);
   NS_LOG_LOGIC ("UID is " << p->GetUid () << ")");
@@ -255,15 +267,16 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
   NS_ASSERT_MSG (m_txMachineState == READY, "Must be READY to transmit");
   m_txMachineState = BUSY;
   m_currentPkt = p;
-  m_phyTxBeginTrace (m_currentPkt);
+  SATNET_TRACE (m_phyTxBeginTrace, m_currentPkt);
+  m_utilization_tracker.TrackUtilization(true);
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
   Time txCompleteTime = txTime + m_tInterframeGap;
 
   NS_LOG_LOGIC ("Schedule TransmitCompleteEvent in " << txCompleteTime.GetSeconds () << "sec");
-  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this, dest);
+  Simulator::Schedule (txCompleteTime, &GSLNetDevice::TransmitComplete, this);
 
-  bool result = m_channel->TransmitStart (p, this, dest, txTime);
+  bool result = m_channel->TransmitTo (p, m_channelIndex, destIndex, txTime);
   if (result == false)
     {
       m_phyTxDropTrace (p);
@@ -274,7 +287,7 @@ GSLNetDevice::TransmitStart (Ptr<Packet> p, const Address dest)
 }
 
 void
-GSLNetDevice::TransmitComplete (const Address dest)
+GSLNetDevice::TransmitComplete (void)
 {
   NS_LOG_FUNCTION (this);
 
@@ -289,7 +302,8 @@ GSLNetDevice::TransmitComplete (const Address dest)
 
   NS_ASSERT_MSG (m_currentPkt != 0, "GSLNetDevice::TransmitComplete(): m_currentPkt zero");
 
-  m_phyTxEndTrace (m_currentPkt);
+  SATNET_TRACE (m_phyTxEndTrace, m_currentPkt);
+  m_utilization_tracker.TrackUtilization(false);
   m_currentPkt = 0;
 
   Ptr<Packet> p = m_queue->Dequeue ();
@@ -298,14 +312,13 @@ GSLNetDevice::TransmitComplete (const Address dest)
       NS_LOG_LOGIC ("No pending packets in device queue after tx complete");
       return;
     }
-    Address next_dest = m_queueDests.front ();
-    m_queueDests.pop ();
+  uint32_t next_dest = PopQueueDest ();
 
   //
   // Got another packet off of the queue, so start the transmit process again.
   //
-  m_snifferTrace (p);
-  m_promiscSnifferTrace (p);
+  SATNET_TRACE (m_snifferTrace, p);
+  SATNET_TRACE (m_promiscSnifferTrace, p);
   TransmitStart (p, next_dest);
 }
 
@@ -316,7 +329,7 @@ GSLNetDevice::Attach (Ptr<GSLChannel> ch)
 
   m_channel = ch;
 
-  m_channel->Attach (this);
+  m_channelIndex = m_channel->Attach (this);
 
   //
   // This device is up whenever it is attached to a channel.  A better plan
@@ -332,6 +345,42 @@ GSLNetDevice::SetQueue (Ptr<Queue<Packet> > q)
 {
   NS_LOG_FUNCTION (this << q);
   m_queue = q;
+
+  // Preallocate the destinations for a full queue
+  QueueSize maxSize = q->GetMaxSize ();
+  std::size_t capacity = (maxSize.GetUnit () == PACKETS ? maxSize.GetValue () : 64);
+  m_queueDests.assign (std::max<std::size_t> (capacity, 1), 0);
+  m_queueDestsHead = 0;
+  m_queueDestsCount = 0;
+}
+
+void
+GSLNetDevice::PushQueueDest (uint32_t destIndex)
+{
+  if (m_queueDestsCount == m_queueDests.size ())
+    {
+      // Only if the queue is not limited in packets: grow, unrolling the ring
+      std::vector<uint32_t> grown (std::max<std::size_t> (2 * m_queueDests.size (), 1));
+      for (std::size_t i = 0; i < m_queueDestsCount; i++)
+        {
+          grown[i] = m_queueDests[(m_queueDestsHead + i) % m_queueDests.size ()];
+        }
+      m_queueDests.swap (grown);
+      m_queueDestsHead = 0;
+    }
+  m_queueDests[(m_queueDestsHead + m_queueDestsCount) % m_queueDests.size ()] = destIndex;
+  m_queueDestsCount++;
+}
+
+uint32_t
+GSLNetDevice::PopQueueDest (void)
+{
+  NS_ABORT_MSG_IF (m_queueDestsCount == 0, "Packet dequeued without destination");
+  uint32_t destIndex = m_queueDests[m_queueDestsHead];
+  m_queueDestsHead = (m_queueDestsHead + 1) % m_queueDests.size ();
+  m_queueDestsCount--;
+  NS_ABORT_MSG_IF (m_queueDestsCount != m_queue->GetNPackets (), "Queue and its destinations are out of sync");
+  return destIndex;
 }
 
 void
@@ -362,15 +411,19 @@ GSLNetDevice::Receive (Ptr<Packet> packet)
       // device because it is so simple, but this is not usually the case in
       // more complicated devices.
       //
-      m_snifferTrace (packet);
-      m_promiscSnifferTrace (packet);
-      m_phyRxEndTrace (packet);
+      SATNET_TRACE (m_snifferTrace, packet);
+      SATNET_TRACE (m_promiscSnifferTrace, packet);
+      SATNET_TRACE (m_phyRxEndTrace, packet);
 
       //
       // Trace sinks will expect complete packets, not packets without some of the
-      // headers.
+      // headers. Only copy if there is any sink to see it.
       //
-      Ptr<Packet> originalPacket = packet->Copy ();
+      Ptr<Packet> originalPacket;
+      if (!m_macRxTrace.IsEmpty () || (!m_promiscCallback.IsNull () && !m_macPromiscRxTrace.IsEmpty ()))
+        {
+          originalPacket = packet->Copy ();
+        }
 
       //
       // Strip off the point-to-point protocol header and forward this packet
@@ -532,24 +585,26 @@ GSLNetDevice::Send (
   //
   AddHeader (packet, protocolNumber);
 
-  m_macTxTrace (packet);
+  SATNET_TRACE (m_macTxTrace, packet);
+
+  // Destination device (aborts if the address is not on the channel)
+  uint32_t destIndex = m_channel->GetDeviceIndex (Mac48Address::ConvertFrom (dest));
 
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
   //
   if (m_queue->Enqueue (packet))
     {
-        m_queueDests.push (dest);
+      PushQueueDest (destIndex);
       //
       // If the channel is ready for transition we send the packet right now
       // 
       if (m_txMachineState == READY)
         {
           packet = m_queue->Dequeue ();
-          Address next_dest = m_queueDests.front ();
-          m_queueDests.pop ();
-          m_snifferTrace (packet);
-          m_promiscSnifferTrace (packet);
+          uint32_t next_dest = PopQueueDest ();
+          SATNET_TRACE (m_snifferTrace, packet);
+          SATNET_TRACE (m_promiscSnifferTrace, packet);
           bool ret = TransmitStart (packet, next_dest);
           return ret;
         }
@@ -659,5 +714,35 @@ GSLNetDevice::EtherToPpp (uint16_t proto)
   return 0;
 }
 
+void
+GSLNetDevice::EnableUtilizationTracking(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, int64_t node_id, int64_t gsl_if_id) {
+    m_utilization_tracker.Enable(interval_ns, writer, std::to_string(node_id) + "," + std::to_string(gsl_if_id));
+}
+
+const std::vector<UtilizationRun>&
+GSLNetDevice::FinalizeUtilization() {
+    return m_utilization_tracker.Finalize();
+}
+
+void
+GSLNetDevice::EnableQueueTracking() {
+    NS_ABORT_MSG_IF(m_queue == 0, "Queue tracking can only be enabled once the queue is set");
+    m_queue_tracking_enabled = true;
+    m_queue_tracking_log = LogUpdateHelper<int64_t>();
+    m_queue_tracking_log.Update(0, 0);
+    m_queue->TraceConnectWithoutContext("PacketsInQueue", MakeCallback(&GSLNetDevice::PacketsInQueueCallback, this));
+}
+
+void
+GSLNetDevice::PacketsInQueueCallback(uint32_t, uint32_t num_packets) {
+    m_queue_tracking_log.Update(Simulator::Now().GetNanoSeconds(), num_packets);
+}
+
+const std::vector<std::tuple<int64_t, int64_t, int64_t>>&
+GSLNetDevice::FinalizeQueueTracking() {
+    NS_ABORT_MSG_UNLESS(m_queue_tracking_enabled, "Queue tracking is not enabled");
+    return m_queue_tracking_log.Finalize(Simulator::Now().GetNanoSeconds());
+}
+
 
 } // namespace ns3
@@ -24,7 +24,7 @@
 #define GSL_NET_DEVICE_H
 
 #include <cstring>
-#include <queue>
+#include <vector>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -37,6 +37,9 @@
 #include "ns3/queue.h"
 #include "ns3/mac48-address.h"
 #include "ns3/node-container.h"
+#include "ns3/log-update-helper.h"
+#include "utilization-tracker.h"
+#include "satnet-trace.h"
 
 namespace ns3 {
 
@@ -55,6 +58,10 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device 
  * include a queue, data rate, and interframe transmission gap (the 
  * propagation delay is set in the GSLChannel).
+ *
+ * If built with NS3_SATNET_TRACE_FREE, the MacTx, Sniffer, PromiscSniffer,
+ * PhyTxBegin, PhyTxEnd and PhyRxEnd trace sources are compiled out, and
+ * connecting to one of them aborts (see satnet-trace.h).
  */
 class GSLNetDevice : public NetDevice
 {
@@ -97,6 +104,13 @@ public:
    */
   void SetInterframeGap (Time t);
 
+  /**
+   * Get the interframe gap used to separate packets.
+   *
+   * \return the interframe gap time
+   */
+  Time GetInterframeGap (void) const;
+
   /**
    * Attach the device to a channel.
    *
@@ -252,10 +266,10 @@ private:
    * \see GSLChannel::TransmitStart ()
    * \see TransmitComplete()
    * \param p a reference to the packet to send
-   * \param address where the packet is to be sent
+   * \param destIndex index in the channel of the device the packet is sent to
    * \returns true if success, false on failure
    */
-  bool TransmitStart (Ptr<Packet> p, const Address address);
+  bool TransmitStart (Ptr<Packet> p, uint32_t destIndex);
 
   /**
    * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
@@ -263,7 +277,21 @@ private:
    * The TransmitComplete method is used internally to finish the process
    * of sending a packet out on the channel.
    */
-  void TransmitComplete (const Address destination);
+  void TransmitComplete (void);
+
+  /**
+   * Append the destination of a packet which was just enqueued.
+   *
+   * \param destIndex index in the channel of the destination device
+   */
+  void PushQueueDest (uint32_t destIndex);
+
+  /**
+   * Remove the destination of the packet which was just dequeued.
+   *
+   * \returns index in the channel of the destination device
+   */
+  uint32_t PopQueueDest (void);
 
   /**
    * \brief Make the link up and running
@@ -303,6 +331,11 @@ private:
    */
   Ptr<GSLChannel> m_channel;
 
+  /**
+   * The index of this device in the GSLChannel
+   */
+  uint32_t m_channelIndex;
+
   /**
    * The Queue which this GSLNetDevice uses as a packet source.
    * Management of this Queue has been delegated to the GSLNetDevice
@@ -311,10 +344,15 @@ private:
    */
   Ptr<Queue<Packet> > m_queue;
 
-    /**
-     * The FIFO queue for the destination MAC addresses
-     */
-  std::queue<Address> m_queueDests;
+  /**
+   * The destination device index (in the channel) of each packet in the Queue,
+   * in the same order: a ring buffer of m_queueDestsCount entries starting
+   * at m_queueDestsHead. It is preallocated to the maximum queue size in
+   * packets, and only grows if the Queue is not limited in packets.
+   */
+  std::vector<uint32_t> m_queueDests;
+  std::size_t m_queueDestsHead;
+  std::size_t m_queueDestsCount;
 
   /**
    * Error model for receive packet events
@@ -325,7 +363,7 @@ private:
    * The trace source fired when packets come into the "top" of the device
    * at the L3/L2 transition, before being queued for transmission.
    */
-  TracedCallback<Ptr<const Packet> > m_macTxTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_macTxTrace;
 
   /**
    * The trace source fired when packets coming into the "top" of the device
@@ -360,13 +398,13 @@ private:
    * The trace source fired when a packet begins the transmission process on
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyTxBeginTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyTxBeginTrace;
 
   /**
    * The trace source fired when a packet ends the transmission process on
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyTxEndTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyTxEndTrace;
 
   /**
    * The trace source fired when the phy layer drops a packet before it tries
@@ -384,7 +422,7 @@ private:
    * The trace source fired when a packet ends the reception process from
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyRxEndTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyRxEndTrace;
 
   /**
    * The trace source fired when the phy layer drops a packet it has received.
@@ -409,7 +447,7 @@ private:
    * this would correspond to the point at which the packet is dispatched to 
    * packet sniffers in \c netif_receive_skb.
    */
-  TracedCallback<Ptr<const Packet> > m_snifferTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_snifferTrace;
 
   /**
    * A trace source that emulates a promiscuous mode protocol sniffer connected
@@ -427,7 +465,7 @@ private:
    * this would correspond to the point at which the packet is dispatched to 
    * packet sniffers in \c netif_receive_skb.
    */
-  TracedCallback<Ptr<const Packet> > m_promiscSnifferTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_promiscSnifferTrace;
 
   Ptr<Node> m_node;                                     //!< Node owning this NetDevice
   Mac48Address m_address;                               //!< Mac48Address of this NetDevice
@@ -465,6 +503,20 @@ private:
    * \return The corresponding PPP protocol number
    */
   static uint16_t EtherToPpp (uint16_t protocol);
+
+private:
+  UtilizationTracker m_utilization_tracker;
+
+  bool m_queue_tracking_enabled = false;
+  LogUpdateHelper<int64_t> m_queue_tracking_log;     // Packets in the device queue over time
+  void PacketsInQueueCallback(uint32_t, uint32_t num_packets);
+
+public:
+    void EnableUtilizationTracking(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, int64_t node_id, int64_t gsl_if_id);
+    const std::vector<UtilizationRun>& FinalizeUtilization();
+    void EnableQueueTracking();
+    const std::vector<std::tuple<int64_t, int64_t, int64_t>>& FinalizeQueueTracking();
+
 };
 
 } // namespace ns3
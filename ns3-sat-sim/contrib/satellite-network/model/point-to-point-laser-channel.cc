@@ -21,8 +21,14 @@
  */
 
 
+#include <algorithm>
+#include <cmath>
+
 #include "point-to-point-laser-channel.h"
 #include "ns3/core-module.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/satellite-ephemeris-mobility-model.h"
+#include "ns3/satellite-position-mobility-model.h"
 
 namespace ns3 {
 
@@ -37,7 +43,7 @@ PointToPointLaserChannel::GetTypeId (void)
     .SetParent<Channel> ()
     .SetGroupName ("PointToPointLaser")
     .AddConstructor<PointToPointLaserChannel> ()
-    .AddAttribute ("Delay", "Initial propagation delay through the channel",
+    .AddAttribute ("Delay", "Propagation delay through the channel at installation; for a remote channel (ISL between two systems) the lower bound of the delay, used as lookahead by the distributed simulator",
                    TimeValue (Seconds (0)),
                    MakeTimeAccessor (&PointToPointLaserChannel::m_initial_delay),
                    MakeTimeChecker ())
@@ -45,6 +51,23 @@ PointToPointLaserChannel::GetTypeId (void)
                    DoubleValue (299792458.0),
                    MakeDoubleAccessor (&PointToPointLaserChannel::m_propagationSpeed),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("DelayModelMaxError",
+                   "Maximum error of the piecewise polynomial delay prediction (0 to compute the exact delay for every packet)",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&PointToPointLaserChannel::m_delayModelMaxError),
+                   MakeTimeChecker ())
+    .AddAttribute ("DelayModelMaxSegment",
+                   "Maximum time span covered by one polynomial of the delay prediction",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&PointToPointLaserChannel::m_delayModelMaxSegment),
+                   MakeTimeChecker (MilliSeconds (1)))
+    .AddAttribute ("ZeroCopy",
+                   "Hand the transmitted packet itself to the receiving device instead of a copy "
+                   "(only if it arrives after the interframe gap of the transmitting device, which uses the "
+                   "packet until then; else it is still copied)",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PointToPointLaserChannel::m_zeroCopy),
+                   MakeBooleanChecker ())
     .AddTraceSource ("TxRxPointToPoint",
                      "Trace source indicating transmission of packet "
                      "from the PointToPointLaserChannel, used by the Animation "
@@ -58,7 +81,13 @@ PointToPointLaserChannel::GetTypeId (void)
 PointToPointLaserChannel::PointToPointLaserChannel()
   :
     Channel (),
-    m_nDevices (0)
+    m_nDevices (0),
+    m_zeroCopy (false),
+    m_delayModelUsable (true),
+    m_segmentStartNs (0),
+    m_segmentLengthNs (0),
+    m_segmentExact (false),
+    m_nextSegmentLengthNs (0)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -103,9 +132,13 @@ PointToPointLaserChannel::TransmitStart (
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
+  // The transmitting device uses the packet until its interframe gap after the transmission
+  // has passed, so it can only be handed over itself if the receiver gets it no earlier
+  bool zeroCopy = m_zeroCopy && delay >= src->GetInterframeGap ();
+
   Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode()->GetId (),
                                   txTime + delay, &PointToPointLaserNetDevice::Receive,
-                                  m_link[wire].m_dst, p->Copy ());
+                                  m_link[wire].m_dst, zeroCopy ? ConstCast<Packet> (p) : p->Copy ());
 
   // Call the tx anim callback on the net device
   m_txrxPointToPoint (p, src, m_link[wire].m_dst, txTime, txTime + delay);
@@ -136,12 +169,162 @@ PointToPointLaserChannel::GetDevice (std::size_t i) const
 
 Time
 PointToPointLaserChannel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  if (m_delayModelUsable && m_delayModelMaxError.IsStrictlyPositive ())
+    {
+      int64_t now_ns = Simulator::Now ().GetNanoSeconds ();
+      if (m_segmentLengthNs == 0 || now_ns < m_segmentStartNs || now_ns >= m_segmentStartNs + m_segmentLengthNs)
+        FitDelayModel (a, b, now_ns);
+
+      if (m_delayModelUsable && !m_segmentExact)
+        {
+          // Newton form of the cubic
+          const double *c = m_segmentCoefficients;
+          double x = (now_ns - m_segmentStartNs) / (double) m_segmentLengthNs;
+          double delay_ns = c[0] + (x - m_segmentNodes[0]) * (c[1] + (x - m_segmentNodes[1]) * (c[2] + (x - m_segmentNodes[2]) * c[3]));
+          return NanoSeconds (std::llround (delay_ns));
+        }
+    }
+
+  return GetExactDelay (a, b);
+}
+
+Time
+PointToPointLaserChannel::GetExactDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
   double distance = a->GetDistanceFrom (b);
   double seconds = distance / m_propagationSpeed;
   return Seconds (seconds);
 }
 
+bool
+PointToPointLaserChannel::GetDelayAt (Ptr<MobilityModel> a, Ptr<MobilityModel> b, int64_t ns, double *delay_ns) const
+{
+  Vector position[2];
+  Ptr<MobilityModel> mobility[2] = {a, b};
+  for (int i = 0; i < 2; i++)
+    {
+      Ptr<SatellitePositionMobilityModel> sgp4 = DynamicCast<SatellitePositionMobilityModel> (mobility[i]);
+      Ptr<SatelliteEphemerisMobilityModel> ephemeris = DynamicCast<SatelliteEphemerisMobilityModel> (mobility[i]);
+      if (sgp4)
+        position[i] = sgp4->GetPositionAt (NanoSeconds (ns));
+      else if (ephemeris)
+        position[i] = ephemeris->GetPositionAt (NanoSeconds (ns));
+      else if (DynamicCast<ConstantPositionMobilityModel> (mobility[i]))
+        position[i] = mobility[i]->GetPosition ();
+      else
+        return false;
+    }
+  *delay_ns = CalculateDistance (position[0], position[1]) / m_propagationSpeed * 1e9;
+  return true;
+}
+
+Time
+PointToPointLaserChannel::GetMinDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const Time &end, const Time &interval) const
+{
+  NS_LOG_FUNCTION (this << end << interval);
+  NS_ASSERT (interval.IsStrictlyPositive ());
+  int64_t end_ns = std::max (end.GetNanoSeconds (), (int64_t) 0);
+  int64_t interval_ns = interval.GetNanoSeconds ();
+
+  // Delay (ns) by which the two nodes can at most approach each other per ns
+  double max_approach_rate = 2 * MAX_ORBITAL_SPEED / m_propagationSpeed;
+
+  double min_delay_ns = 0;
+  double previous_delay_ns = 0;
+  int64_t previous_ns = 0;
+  for (int64_t t_ns = 0; ; t_ns = std::min (t_ns + interval_ns, end_ns))
+    {
+      double delay_ns;
+      if (!GetDelayAt (a, b, t_ns, &delay_ns))
+        return Seconds (0);
+
+      // Lowest point both bounds d(t_k) - r (t - t_k) and d(t_k+1) - r (t_k+1 - t) allow in between
+      if (t_ns == 0)
+        min_delay_ns = delay_ns;
+      else
+        min_delay_ns = std::min (min_delay_ns, (previous_delay_ns + delay_ns - max_approach_rate * (t_ns - previous_ns)) / 2);
+
+      previous_delay_ns = delay_ns;
+      previous_ns = t_ns;
+      if (t_ns >= end_ns)
+        break;
+    }
+  return NanoSeconds ((int64_t) std::floor (std::max (min_delay_ns, 0.0)));
+}
+
+Time
+PointToPointLaserChannel::GetLowerBoundDelay (void) const
+{
+  return m_initial_delay;
+}
+
+void
+PointToPointLaserChannel::FitDelayModel (Ptr<MobilityModel> a, Ptr<MobilityModel> b, int64_t now_ns) const
+{
+  NS_LOG_FUNCTION (this << now_ns);
+
+  int64_t max_segment_ns = m_delayModelMaxSegment.GetNanoSeconds ();
+  int64_t length_ns = m_nextSegmentLengthNs > 0 ? std::min (m_nextSegmentLengthNs, max_segment_ns) : max_segment_ns;
+  while (true)
+    {
+      // Exact delays at the 4 nodes (0, 1/3, 2/3, 1) and at the 3 points in between
+      int64_t offset_ns[7];
+      double x[7], d[7];
+      for (int k = 0; k < 7; k++)
+        {
+          offset_ns[k] = length_ns * k / 6;
+          x[k] = offset_ns[k] / (double) length_ns;
+          if (!GetDelayAt (a, b, now_ns + offset_ns[k], &d[k]))
+            {
+              NS_LOG_WARN ("Positions over time unknown, falling back to exact delay");
+              m_delayModelUsable = false;
+              return;
+            }
+        }
+
+      // Newton divided differences through the even points
+      double xn[4] = {x[0], x[2], x[4], x[6]};
+      double c[4] = {d[0], d[2], d[4], d[6]};
+      for (int j = 1; j < 4; j++)
+        {
+          for (int i = 3; i >= j; i--)
+            c[i] = (c[i] - c[i - 1]) / (xn[i] - xn[i - j]);
+        }
+
+      // Deviation at the odd points
+      double max_error_ns = 0.0;
+      for (int k = 1; k < 7; k += 2)
+        {
+          double p = c[0] + (x[k] - xn[0]) * (c[1] + (x[k] - xn[1]) * (c[2] + (x[k] - xn[2]) * c[3]));
+          max_error_ns = std::max (max_error_ns, std::abs (p - d[k]));
+        }
+
+      if (max_error_ns <= m_delayModelMaxError.GetNanoSeconds ())
+        {
+          m_segmentStartNs = now_ns;
+          m_segmentLengthNs = length_ns;
+          m_segmentExact = false;
+          m_nextSegmentLengthNs = std::min (2 * length_ns, max_segment_ns);
+          std::copy (xn, xn + 3, m_segmentNodes);
+          std::copy (c, c + 4, m_segmentCoefficients);
+          return;
+        }
+
+      // Even the shortest segment is not accurate enough, so the exact delay is used over it
+      if (length_ns <= MIN_SEGMENT_NS)
+        {
+          NS_LOG_LOGIC ("Fit error " << max_error_ns << " ns over the shortest segment, using the exact delay");
+          m_segmentStartNs = now_ns;
+          m_segmentLengthNs = length_ns;
+          m_segmentExact = true;
+          m_nextSegmentLengthNs = std::min (2 * length_ns, max_segment_ns);
+          return;
+        }
+      length_ns = std::max (length_ns / 2, MIN_SEGMENT_NS);
+    }
+}
+
 Ptr<PointToPointLaserNetDevice>
 PointToPointLaserChannel::GetSource (uint32_t i) const
 {
@@ -52,6 +52,19 @@ class Packet;
  * 
  * (PointToPointChannel with mobile nodes)
  *
+ * The propagation delay is by default computed from the positions of both
+ * nodes for every packet. If DelayModelMaxError is set, the delay is instead
+ * predicted by a piecewise cubic polynomial: a segment starting at the
+ * current time is fitted through 4 exact delays, and its length is halved
+ * until the fit deviates at most DelayModelMaxError at the points in between
+ * (and doubled again for the next segment, up to DelayModelMaxSegment). Per
+ * packet, the delay is then a polynomial evaluation. If even a segment of the
+ * shortest length (1 ms) deviates more, the exact delay is computed for every
+ * packet during that millisecond instead. This requires the nodes to use a
+ * satellite (or constant position) mobility model. A remote channel (ISL
+ * between two systems) ignores DelayModelMaxError, as the prediction could
+ * fall below its lookahead.
+ *
  */
 class PointToPointLaserChannel : public Channel 
 {
@@ -120,7 +133,31 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Get a lower bound of the delay between two nodes over a time span
+   *
+   * The exact delay is sampled at the given interval. In between two samples,
+   * the distance cannot shrink faster than the maximum speed of two objects
+   * in orbit towards each other.
+   *
+   * \param a mobility of one node
+   * \param b mobility of the other node
+   * \param end the end of the time span, which starts at 0
+   * \param interval the interval between two samples
+   *
+   * \returns lower bound of the delay (0 if the positions over time are unknown)
+   */
+  Time GetMinDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b, const Time &end, const Time &interval) const;
+
 protected:
+  /**
+   * \brief Get the Delay attribute, which is only a lower bound of the
+   *        delay for a remote channel (ISL between two systems)
+   *
+   * \returns Time value of the Delay attribute
+   */
+  Time GetLowerBoundDelay (void) const;
+
   /**
    * \brief Get the delay between two nodes on this channel
    * 
@@ -129,7 +166,39 @@ protected:
    * 
    * \returns Time delay
    */
-  Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
+  virtual Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
+
+  /**
+   * \brief Get the exact delay between two nodes on this channel now,
+   *        without the delay model
+   *
+   * \param senderMobility location of the sender
+   * \param receiverMobility location of the receiver
+   *
+   * \returns Time delay
+   */
+  Time GetExactDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
+
+  /**
+   * \brief Get the exact delay between two nodes at a given time
+   *
+   * \param a mobility of one node
+   * \param b mobility of the other node
+   * \param ns the simulation time (ns)
+   * \param delay_ns set to the delay (ns)
+   *
+   * \returns true if the positions at that time are known
+   */
+  bool GetDelayAt (Ptr<MobilityModel> a, Ptr<MobilityModel> b, int64_t ns, double *delay_ns) const;
+
+  /**
+   * \brief Fit the delay model segment that starts at the given time
+   *
+   * \param a mobility of one node
+   * \param b mobility of the other node
+   * \param now_ns the start of the segment (ns)
+   */
+  void FitDelayModel (Ptr<MobilityModel> a, Ptr<MobilityModel> b, int64_t now_ns) const;
 
   /**
    * \brief Check to make sure the link is initialized
@@ -185,11 +254,28 @@ private:
   /** Each point to point link has exactly two net devices. */
   static const std::size_t N_DEVICES = 2;
 
-  Time               m_initial_delay;     //!< Propagation delay at the initial distance
-                                          //   used to give a delay estimate to the
-                                          //   distributed simulator
+  Time               m_initial_delay;     //!< Initial propagation delay; for a remote
+                                          //   channel, the lower bound of the delay used
+                                          //   as lookahead by the distributed simulator
   double             m_propagationSpeed;  //!< propagation speed on the channel
   std::size_t        m_nDevices;          //!< Devices of this channel
+  bool               m_zeroCopy;          //!< Pass the packet itself (not a copy) to the receiver if it arrives after the interframe gap
+
+  /** Escape velocity at the Earth's surface (m/s), which nothing in orbit exceeds */
+  static constexpr double MAX_ORBITAL_SPEED = 11186.0;
+
+  /** Shortest delay model segment; if its fit is not accurate enough, the exact delay is used over it */
+  static constexpr int64_t MIN_SEGMENT_NS = 1000000;
+
+  Time               m_delayModelMaxError;    //!< Maximum fit error (0 = exact delay per packet)
+  Time               m_delayModelMaxSegment;  //!< Maximum length of a delay model segment
+  mutable bool       m_delayModelUsable;      //!< False if the positions over time are unknown
+  mutable int64_t    m_segmentStartNs;        //!< Start of the current segment
+  mutable int64_t    m_segmentLengthNs;       //!< Length of the current segment (0 = none)
+  mutable bool       m_segmentExact;          //!< True if the exact delay is used over the current segment
+  mutable int64_t    m_nextSegmentLengthNs;   //!< Length to try first for the next segment
+  mutable double     m_segmentNodes[3];       //!< First three interpolation nodes (fraction of segment)
+  mutable double     m_segmentCoefficients[4]; //!< Newton coefficients of the delay (ns)
 
   /**
    * The trace source for the packet transmission animation events that the 
@@ -237,6 +237,13 @@ PointToPointLaserNetDevice::SetInterframeGap (Time t)
   m_tInterframeGap = t;
 }
 
+Time
+PointToPointLaserNetDevice::GetInterframeGap (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_tInterframeGap;
+}
+
 bool
 PointToPointLaserNetDevice::TransmitStart (Ptr<Packet> p)
 {
@@ -251,8 +258,8 @@ PointToPointLaserNetDevice::TransmitStart (Ptr<Packet> p)
   NS_ASSERT_MSG (m_txMachineState == READY, "Must be READY to transmit");
   m_txMachineState = BUSY;
   m_currentPkt = p;
-  m_phyTxBeginTrace (m_currentPkt);
-  TrackUtilization(true);
+  SATNET_TRACE (m_phyTxBeginTrace, m_currentPkt);
+  m_utilization_tracker.TrackUtilization(true);
 
   Time txTime = m_bps.CalculateBytesTxTime (p->GetSize ());
   Time txCompleteTime = txTime + m_tInterframeGap;
@@ -284,8 +291,8 @@ PointToPointLaserNetDevice::TransmitComplete (void)
 
   NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointLaserNetDevice::TransmitComplete(): m_currentPkt zero");
 
-  m_phyTxEndTrace (m_currentPkt);
-  TrackUtilization(false);
+  SATNET_TRACE (m_phyTxEndTrace, m_currentPkt);
+  m_utilization_tracker.TrackUtilization(false);
   m_currentPkt = 0;
 
   Ptr<Packet> p = m_queue->Dequeue ();
@@ -298,8 +305,8 @@ PointToPointLaserNetDevice::TransmitComplete (void)
   //
   // Got another packet off of the queue, so start the transmit process again.
   //
-  m_snifferTrace (p);
-  m_promiscSnifferTrace (p);
+  SATNET_TRACE (m_snifferTrace, p);
+  SATNET_TRACE (m_promiscSnifferTrace, p);
   TransmitStart (p);
 }
 
@@ -356,15 +363,19 @@ PointToPointLaserNetDevice::Receive (Ptr<Packet> packet)
       // device because it is so simple, but this is not usually the case in
       // more complicated devices.
       //
-      m_snifferTrace (packet);
-      m_promiscSnifferTrace (packet);
-      m_phyRxEndTrace (packet);
+      SATNET_TRACE (m_snifferTrace, packet);
+      SATNET_TRACE (m_promiscSnifferTrace, packet);
+      SATNET_TRACE (m_phyRxEndTrace, packet);
 
       //
       // Trace sinks will expect complete packets, not packets without some of the
-      // headers.
+      // headers. Only copy if there is any sink to see it.
       //
-      Ptr<Packet> originalPacket = packet->Copy ();
+      Ptr<Packet> originalPacket;
+      if (!m_macRxTrace.IsEmpty () || (!m_promiscCallback.IsNull () && !m_macPromiscRxTrace.IsEmpty ()))
+        {
+          originalPacket = packet->Copy ();
+        }
 
       //
       // Strip off the point-to-point protocol header and forward this packet
@@ -549,7 +560,7 @@ PointToPointLaserNetDevice::Send (
   //
   AddHeader (packet, protocolNumber);
 
-  m_macTxTrace (packet);
+  SATNET_TRACE (m_macTxTrace, packet);
 
   //
   // We should enqueue and dequeue the packet to hit the tracing hooks.
@@ -562,8 +573,8 @@ PointToPointLaserNetDevice::Send (
       if (m_txMachineState == READY)
         {
           packet = m_queue->Dequeue ();
-          m_snifferTrace (packet);
-          m_promiscSnifferTrace (packet);
+          SATNET_TRACE (m_snifferTrace, packet);
+          SATNET_TRACE (m_promiscSnifferTrace, packet);
           bool ret = TransmitStart (packet);
           return ret;
         }
@@ -693,66 +704,17 @@ PointToPointLaserNetDevice::EtherToPpp (uint16_t proto)
 
 void
 PointToPointLaserNetDevice::EnableUtilizationTracking(int64_t interval_ns) {
-    m_utilization_tracking_enabled = true;
-    m_interval_ns = interval_ns;
-    m_prev_time_ns = 0;
-    m_current_interval_start = 0;
-    m_current_interval_end = m_interval_ns;
-    m_idle_time_counter_ns = 0;
-    m_busy_time_counter_ns = 0;
-    m_current_state_is_on = false;
+    m_utilization_tracker.Enable(interval_ns, 0, "");
 }
 
 void
-PointToPointLaserNetDevice::TrackUtilization(bool next_state_is_on) {
-    if (m_utilization_tracking_enabled) {
-
-        // Current time in nanoseconds
-        int64_t now_ns = Simulator::Now().GetNanoSeconds();
-        while (now_ns >= m_current_interval_end) {
-
-            // Add everything until the end of the interval
-            if (next_state_is_on) {
-                m_idle_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            } else {
-                m_busy_time_counter_ns += m_current_interval_end - m_prev_time_ns;
-            }
-
-            // Save into the utilization array
-            m_utilization.push_back(((double) m_busy_time_counter_ns) / ((double) m_interval_ns));
-
-            // This must match up
-            NS_ABORT_MSG_IF(m_idle_time_counter_ns + m_busy_time_counter_ns != m_interval_ns, "Not all time is accounted for");
-
-            // Move to next interval
-            m_idle_time_counter_ns = 0;
-            m_busy_time_counter_ns = 0;
-            m_prev_time_ns = m_current_interval_end;
-            m_current_interval_start += m_interval_ns;
-            m_current_interval_end += m_interval_ns;
-        }
-
-        // If not at the end of a new interval, just keep track of it all
-        if (next_state_is_on) {
-            m_idle_time_counter_ns += now_ns - m_prev_time_ns;
-        } else {
-            m_busy_time_counter_ns += now_ns - m_prev_time_ns;
-        }
-
-        // This has become the previous call
-        m_current_state_is_on = next_state_is_on;
-        m_prev_time_ns = now_ns;
-
-    }
+PointToPointLaserNetDevice::EnableUtilizationTracking(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, int64_t src, int64_t dst) {
+    m_utilization_tracker.Enable(interval_ns, writer, std::to_string(src) + "," + std::to_string(dst));
 }
 
-
-
-const std::vector<double>&
+const std::vector<UtilizationRun>&
 PointToPointLaserNetDevice::FinalizeUtilization() {
-    TrackUtilization(!m_current_state_is_on);
-    return m_utilization;
+    return m_utilization_tracker.Finalize();
 }
 
-
 } // namespace ns3
@@ -36,6 +36,8 @@
 #include "ns3/data-rate.h"
 #include "ns3/ptr.h"
 #include "ns3/mac48-address.h"
+#include "utilization-tracker.h"
+#include "satnet-trace.h"
 
 namespace ns3 {
 
@@ -56,6 +58,10 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device 
  * include a queue, data rate, and interframe transmission gap (the 
  * propagation delay is set in the PointToPointLaserChannel).
+ *
+ * If built with NS3_SATNET_TRACE_FREE, the MacTx, Sniffer, PromiscSniffer,
+ * PhyTxBegin, PhyTxEnd and PhyRxEnd trace sources are compiled out, and
+ * connecting to one of them aborts (see satnet-trace.h).
  */
 class PointToPointLaserNetDevice : public NetDevice
 {
@@ -98,6 +104,13 @@ public:
    */
   void SetInterframeGap (Time t);
 
+  /**
+   * Get the interframe gap used to separate packets.
+   *
+   * \return the interframe gap time
+   */
+  Time GetInterframeGap (void) const;
+
   /**
    * Attach the device to a channel.
    *
@@ -329,7 +342,7 @@ private:
    * The trace source fired when packets come into the "top" of the device
    * at the L3/L2 transition, before being queued for transmission.
    */
-  TracedCallback<Ptr<const Packet> > m_macTxTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_macTxTrace;
 
   /**
    * The trace source fired when packets coming into the "top" of the device
@@ -364,13 +377,13 @@ private:
    * The trace source fired when a packet begins the transmission process on
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyTxBeginTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyTxBeginTrace;
 
   /**
    * The trace source fired when a packet ends the transmission process on
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyTxEndTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyTxEndTrace;
 
   /**
    * The trace source fired when the phy layer drops a packet before it tries
@@ -388,7 +401,7 @@ private:
    * The trace source fired when a packet ends the reception process from
    * the medium.
    */
-  TracedCallback<Ptr<const Packet> > m_phyRxEndTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_phyRxEndTrace;
 
   /**
    * The trace source fired when the phy layer drops a packet it has received.
@@ -413,7 +426,7 @@ private:
    * this would correspond to the point at which the packet is dispatched to 
    * packet sniffers in \c netif_receive_skb.
    */
-  TracedCallback<Ptr<const Packet> > m_snifferTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_snifferTrace;
 
   /**
    * A trace source that emulates a promiscuous mode protocol sniffer connected
@@ -431,7 +444,7 @@ private:
    * this would correspond to the point at which the packet is dispatched to 
    * packet sniffers in \c netif_receive_skb.
    */
-  TracedCallback<Ptr<const Packet> > m_promiscSnifferTrace;
+  SatnetTracedCallback<Ptr<const Packet> > m_promiscSnifferTrace;
 
   Ptr<Node> m_node;              //!< Node owning this NetDevice
   Ptr<Node> m_destination_node;  //!< Node at the other end of the p2pLaserLink
@@ -472,20 +485,12 @@ private:
   static uint16_t EtherToPpp (uint16_t protocol);
 
 private:
-  bool m_utilization_tracking_enabled = false;
-  int64_t m_interval_ns;
-  int64_t m_prev_time_ns;
-  int64_t m_current_interval_start;
-  int64_t m_current_interval_end;
-  int64_t m_idle_time_counter_ns;
-  int64_t m_busy_time_counter_ns;
-  bool m_current_state_is_on;
-  std::vector<double> m_utilization;
-  void TrackUtilization(bool next_state_is_on);
+  UtilizationTracker m_utilization_tracker;
 
 public:
     void EnableUtilizationTracking(int64_t interval_ns);
-    const std::vector<double>& FinalizeUtilization();
+    void EnableUtilizationTracking(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, int64_t src, int64_t dst);
+    const std::vector<UtilizationRun>& FinalizeUtilization();
 
 };
 
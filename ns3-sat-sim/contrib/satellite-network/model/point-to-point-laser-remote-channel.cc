@@ -29,6 +29,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/mpi-interface.h"
 
 namespace ns3 {
@@ -77,6 +78,10 @@ PointToPointLaserRemoteChannel::TransmitStart (
   Ptr<PointToPointLaserNetDevice> dst = GetDestination (wire);
 
 #ifdef NS3_MPI
+  // The lower bound is the lookahead: arriving any earlier would violate causality
+  NS_ABORT_MSG_IF (txTime + delay < GetLowerBoundDelay (),
+                   "ISL delay " << delay << " is below the lower bound " << GetLowerBoundDelay ());
+
   // Calculate the rxTime (absolute)
   Time rxTime = Simulator::Now () + txTime + delay;
   MpiInterface::SendPacket (p->Copy (), rxTime, dst->GetNode()->GetId (), dst->GetIfIndex());
@@ -86,4 +91,10 @@ PointToPointLaserRemoteChannel::TransmitStart (
   return true;
 }
 
+Time
+PointToPointLaserRemoteChannel::GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const
+{
+  return GetExactDelay (senderMobility, receiverMobility);
+}
+
 } // namespace ns3
@@ -69,6 +69,20 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointLaserNetDevice> src,
                               Ptr<Node> node_other_end, Time txTime);
+
+protected:
+  /**
+   * \brief Get the exact delay between two nodes on this channel
+   *
+   * The delay model is not used, as its prediction can be up to its maximum
+   * error below the exact delay, and with that below the lookahead.
+   *
+   * \param senderMobility location of the sender
+   * \param receiverMobility location of the receiver
+   *
+   * \returns Time delay
+   */
+  virtual Time GetDelay (Ptr<MobilityModel> senderMobility, Ptr<MobilityModel> receiverMobility) const;
 };
 
 } // namespace ns3
@@ -0,0 +1,64 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SATNET_TRACE_H
+#define SATNET_TRACE_H
+
+#include <string>
+#include "ns3/traced-callback.h"
+#include "ns3/abort.h"
+#include "ns3/satnet-trace-config.h"
+
+namespace ns3 {
+
+// With the NS3_SATNET_TRACE_FREE build option, the per-packet trace sources
+// of the GSL and ISL net devices (MacTx, Sniffer, PromiscSniffer, PhyTxBegin,
+// PhyTxEnd, PhyRxEnd) are compiled out. They stay registered, but as they
+// would never fire, connecting to one of them aborts.
+#ifdef NS3_SATNET_TRACE_FREE
+
+#define SATNET_TRACE(trace, packet)
+
+template <typename... Ts>
+class SatnetTracedCallback : public TracedCallback<Ts...>
+{
+public:
+  void ConnectWithoutContext (const CallbackBase &callback)
+  {
+    NS_FATAL_ERROR ("Cannot connect to a per-packet trace source of a satellite network device, "
+                    "as it is compiled out (built with NS3_SATNET_TRACE_FREE)");
+  }
+  void Connect (const CallbackBase &callback, std::string path)
+  {
+    NS_FATAL_ERROR ("Cannot connect to per-packet trace source " << path << ", "
+                    "as it is compiled out (built with NS3_SATNET_TRACE_FREE)");
+  }
+};
+
+#else
+
+#define SATNET_TRACE(trace, packet) trace (packet)
+
+template <typename... Ts>
+using SatnetTracedCallback = TracedCallback<Ts...>;
+
+#endif
+
+} // namespace ns3
+
+#endif /* SATNET_TRACE_H */
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "single-forward-table.h"
+
+#include <stdexcept>
+
+namespace ns3 {
+
+static_assert(sizeof(SingleForwardEntry) == 8, "Forwarding table entry must be packed into 8 bytes");
+
+SingleForwardTable::SingleForwardTable(int64_t num_nodes, const std::set<int64_t>& destinations) {
+    m_num_nodes = num_nodes;
+    m_node_to_column.assign(num_nodes, -1);
+    for (int64_t node_id : destinations) {
+        if (node_id < 0 || node_id >= num_nodes) {
+            throw std::invalid_argument("Destination node id is out of range");
+        }
+        m_node_to_column[node_id] = (int32_t) m_destinations.size();
+        m_destinations.push_back(node_id);
+    }
+    m_entries.assign(num_nodes * m_destinations.size(), {-2, -2, -2}); // -2 indicates an invalid entry
+    m_gateways.assign(num_nodes * m_destinations.size(), 0);
+}
+
+int64_t SingleForwardTable::GetNumNodes() const {
+    return m_num_nodes;
+}
+
+const std::vector<int64_t>& SingleForwardTable::GetDestinations() const {
+    return m_destinations;
+}
+
+size_t SingleForwardTable::GetSizeByte() const {
+    return m_entries.size() * sizeof(SingleForwardEntry) + m_gateways.size() * sizeof(uint32_t) + m_node_to_column.size() * sizeof(int32_t) + m_destinations.size() * sizeof(int64_t);
+}
+
+}
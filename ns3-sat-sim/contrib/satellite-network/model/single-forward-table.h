@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SINGLE_FORWARD_TABLE_H
+#define SINGLE_FORWARD_TABLE_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * Next hop of a node towards a destination: -2 in all three is invalid (not set),
+ * -1 in all three is a drop. Packed into 8 bytes.
+ */
+struct SingleForwardEntry {
+    int32_t next_node_id;
+    int16_t own_if_id;
+    int16_t next_if_id;
+};
+
+/**
+ * Forwarding state of all nodes in one contiguous table, shared by the arbiters:
+ * a row per node, with a column for each destination node only (in a satellite
+ * network, the ground stations). Memory is O(nodes x destinations) entries of
+ * 8 bytes, instead of O(nodes x nodes). Alongside, a table of the same shape
+ * holds the IPv4 address of the next hop interface (the gateway) of each entry.
+ */
+class SingleForwardTable : public SimpleRefCount<SingleForwardTable> {
+
+public:
+    SingleForwardTable(int64_t num_nodes, const std::set<int64_t>& destinations);
+    int64_t GetNumNodes() const;
+    const std::vector<int64_t>& GetDestinations() const;
+    size_t GetSizeByte() const;
+
+    // Column of a destination node id (-1 if it is not a destination)
+    int32_t GetColumn(int64_t target_node_id) const {
+        return m_node_to_column[target_node_id];
+    }
+
+    // First entry of the row of a node, its columns follow contiguously
+    SingleForwardEntry* GetRow(int64_t node_id) {
+        return m_entries.data() + node_id * m_destinations.size();
+    }
+
+    // Gateway IPv4 address of the first entry of the row of a node (0 if none)
+    uint32_t* GetGatewayRow(int64_t node_id) {
+        return m_gateways.data() + node_id * m_destinations.size();
+    }
+
+private:
+    int64_t m_num_nodes;
+    std::vector<int64_t> m_destinations;        // Column -> destination node id (ascending)
+    std::vector<int32_t> m_node_to_column;      // Node id -> column (-1 if not a destination)
+    std::vector<SingleForwardEntry> m_entries;  // [node][column]
+    std::vector<uint32_t> m_gateways;           // [node][column]
+
+};
+
+}
+
+#endif //SINGLE_FORWARD_TABLE_H
@@ -35,6 +35,8 @@ namespace ns3 {
 
     TopologySatelliteNetwork::TopologySatelliteNetwork(Ptr<BasicSimulation> basicSimulation, const Ipv4RoutingHelper& ipv4RoutingHelper) {
         m_basicSimulation = basicSimulation;
+        m_min_satellite_perigee_radius_m = std::numeric_limits<double>::max();
+        m_max_ground_station_radius_m = 0.0;
         ReadConfig();
         Build(ipv4RoutingHelper);
     }
@@ -43,12 +45,43 @@ namespace ns3 {
         m_satellite_network_dir = m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("satellite_network_dir");
         m_satellite_network_routes_dir =  m_basicSimulation->GetRunDir() + "/" + m_basicSimulation->GetConfigParamOrFail("satellite_network_routes_dir");
         m_satellite_network_force_static = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("satellite_network_force_static", "false"));
+        m_satellite_position_cache_quantum_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_position_cache_quantum_ns", "0"));
+        m_satellite_ephemeris_file = m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_file", "");
+        if (m_satellite_ephemeris_file != "") {
+            m_satellite_ephemeris_file = m_basicSimulation->GetRunDir() + "/" + m_satellite_ephemeris_file;
+        }
+        m_satellite_mobility_model = m_basicSimulation->GetConfigParamOrDefault("satellite_mobility_model", m_satellite_ephemeris_file == "" ? "sgp4" : "ephemeris");
+        if (m_satellite_mobility_model != "sgp4" && m_satellite_mobility_model != "ephemeris") {
+            throw std::invalid_argument("Invalid satellite mobility model (must be sgp4 or ephemeris): " + m_satellite_mobility_model);
+        }
+        if (m_satellite_ephemeris_file != "" && m_satellite_mobility_model != "ephemeris") {
+            throw std::invalid_argument("A satellite ephemeris file can only be used with the ephemeris mobility model");
+        }
+        m_satellite_ephemeris_interval_ns = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_interval_ns", "10000000000"));
+        m_satellite_ephemeris_num_threads = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("satellite_ephemeris_num_threads", "0"));
+        m_channel_zero_copy = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("channel_zero_copy", "false"));
+        m_isl_lookahead_sample_interval_ns = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault("isl_lookahead_sample_interval_ns", "1000000000"));
+        m_gsl_delay_cache_quantum_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("gsl_delay_cache_quantum_ns", "0"));
+        m_isl_delay_model_max_error_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrDefault("isl_delay_model_max_error_ns", "0"));
+        m_isl_delay_model_max_segment_ns = parse_geq_one_int64(m_basicSimulation->GetConfigParamOrDefault(
+                "isl_delay_model_max_segment_ns",
+                m_basicSimulation->GetConfigParamOrDefault("dynamic_state_update_interval_ns", "1000000000")
+        ));
+        if (m_isl_delay_model_max_segment_ns < 1000000) {
+            throw std::invalid_argument("ISL delay model segments must be at least 1 ms");
+        }
     }
 
     void
     TopologySatelliteNetwork::Build(const Ipv4RoutingHelper& ipv4RoutingHelper) {
         std::cout << "SATELLITE NETWORK" << std::endl;
 
+        // Node-to-system-id assignment determined from the constellation
+        if (m_basicSimulation->IsDistributedEnabled() && m_basicSimulation->IsDistributedNodeSystemIdAssignmentAuto()) {
+            AssignNodesToSystems();
+            m_basicSimulation->RegisterTimestamp("Assign nodes to systems");
+        }
+
         // Initialize satellites
         ReadSatellites();
         std::cout << "  > Number of satellites........ " << m_satelliteNodes.GetN() << std::endl;
@@ -67,6 +100,16 @@ namespace ns3 {
         m_allNodes.Add(m_groundStationNodes);
         std::cout << "  > Number of nodes............. " << m_allNodes.GetN() << std::endl;
 
+        // Check that each node has an assignment to a system id if it is distributed
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            size_t node_assignment_size = m_basicSimulation->GetDistributedNodeSystemIdAssignment().size();
+            if (node_assignment_size != (size_t) m_allNodes.GetN()) {
+                throw std::invalid_argument(
+                        format_string("Incorrect amount of node-to-system-id assignments (must be %u but got %u)", m_allNodes.GetN(), node_assignment_size)
+                );
+            }
+        }
+
         // Install internet stacks on all nodes
         InstallInternetStacks(ipv4RoutingHelper);
         std::cout << "  > Installed Internet stacks" << std::endl;
@@ -84,7 +127,19 @@ namespace ns3 {
         m_enable_isl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrFail("enable_isl_utilization_tracking"));
         if (m_enable_isl_utilization_tracking) {
             m_isl_utilization_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("isl_utilization_tracking_interval_ns"));
+
+            // Optionally, completed runs are streamed to the log file during the run instead of kept in memory
+            if (parse_boolean(m_basicSimulation->GetConfigParamOrDefault("isl_utilization_tracking_streaming", "false"))) {
+                m_islUtilizationWriter = Create<UtilizationRunWriter>(m_basicSimulation->GetLogsDir() + "/isl_utilization.csv", 1 << 20);
+            }
+        }
+
+        // GSL tracking settings
+        m_enable_gsl_utilization_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_gsl_utilization_tracking", "false"));
+        if (m_enable_gsl_utilization_tracking) {
+            m_gsl_utilization_tracking_interval_ns = parse_positive_int64(m_basicSimulation->GetConfigParamOrFail("gsl_utilization_tracking_interval_ns"));
         }
+        m_enable_gsl_queue_tracking = parse_boolean(m_basicSimulation->GetConfigParamOrDefault("enable_gsl_queue_tracking", "false"));
 
         // Create ISLs
         std::cout << "  > Reading and creating ISLs" << std::endl;
@@ -119,8 +174,22 @@ namespace ns3 {
         int64_t num_orbits = parse_positive_int64(res[0]);
         int64_t satellites_per_orbit = parse_positive_int64(res[1]);
 
-        // Create the nodes
-        m_satelliteNodes.Create(num_orbits * satellites_per_orbit);
+        // Position cache shared by all satellites, such that each is propagated at most once per quantum
+        if (!m_satellite_network_force_static && m_satellite_mobility_model == "sgp4" && m_satellite_position_cache_quantum_ns > 0) {
+            m_satellitePositionCache = CreateObject<SatellitePositionCache>();
+            m_satellitePositionCache->SetQuantum(NanoSeconds(m_satellite_position_cache_quantum_ns));
+            std::cout << "  > Satellite position cache quantum... " << m_satellite_position_cache_quantum_ns << " ns" << std::endl;
+        }
+
+        // Ephemeris is sampled over the entire simulation
+        // (or loaded from a file, in which case the satellites need no orbit)
+        bool use_ephemeris = !m_satellite_network_force_static && m_satellite_mobility_model == "ephemeris";
+        bool load_ephemeris = use_ephemeris && m_satellite_ephemeris_file != "";
+        if (load_ephemeris) {
+            std::cout << "  > Satellite ephemeris file... " << m_satellite_ephemeris_file << std::endl;
+        } else if (use_ephemeris) {
+            std::cout << "  > Satellite ephemeris interval... " << m_satellite_ephemeris_interval_ns << " ns" << std::endl;
+        }
 
         // Associate satellite mobility model with each node
         int64_t counter = 0;
@@ -134,10 +203,20 @@ namespace ns3 {
             // <TLE line 1>
             // <TLE line 2>
 
+            // Create the node
+            CreateNode(m_satelliteNodes, counter);
+
+            // Lowest point of the orbit bounds the GSL delay from below
+            m_min_satellite_perigee_radius_m = std::min(m_min_satellite_perigee_radius_m, GetPerigeeRadius(tle2));
+
             // Create satellite
             Ptr<Satellite> satellite = CreateObject<Satellite>();
             satellite->SetName(name);
-            satellite->SetTleInfo(tle1, tle2);
+            if (!load_ephemeris) {
+                satellite->SetTleInfo(tle1, tle2);
+            } else {
+                m_satelliteTles.push_back(std::make_pair(tle1, tle2));
+            }
 
             // Decide the mobility model of the satellite
             MobilityHelper mobility;
@@ -149,13 +228,27 @@ namespace ns3 {
                 Ptr<MobilityModel> mobModel = m_satelliteNodes.Get(counter)->GetObject<MobilityModel>();
                 mobModel->SetPosition(satellite->GetPosition(satellite->GetTleEpoch()));
 
+            } else if (m_satellite_mobility_model == "ephemeris") {
+
+                // Dynamic, interpolated from a precomputed ephemeris
+                mobility.SetMobilityModel(
+                        "ns3::SatelliteEphemerisMobilityModel",
+                        "SatellitePositionHelper",
+                        SatellitePositionHelperValue(SatellitePositionHelper(satellite)),
+                        "SampleInterval",
+                        TimeValue(NanoSeconds(m_satellite_ephemeris_interval_ns))
+                );
+                mobility.Install(m_satelliteNodes.Get(counter));
+
             } else {
 
                 // Dynamic
                 mobility.SetMobilityModel(
                         "ns3::SatellitePositionMobilityModel",
                         "SatellitePositionHelper",
-                        SatellitePositionHelperValue(SatellitePositionHelper(satellite))
+                        SatellitePositionHelperValue(SatellitePositionHelper(satellite)),
+                        "PositionCache",
+                        PointerValue(m_satellitePositionCache)
                 );
                 mobility.Install(m_satelliteNodes.Get(counter));
 
@@ -173,6 +266,90 @@ namespace ns3 {
         }
 
         fs.close();
+
+        // Sample all satellites at once before the simulation starts
+        if (load_ephemeris) {
+            m_basicSimulation->RegisterTimestamp("Read satellites");
+            LoadSatelliteEphemeris();
+            m_basicSimulation->RegisterTimestamp("Load satellite ephemeris");
+        } else if (use_ephemeris) {
+            m_basicSimulation->RegisterTimestamp("Read satellites");
+            BuildSatelliteEphemeris();
+            m_basicSimulation->RegisterTimestamp("Build satellite ephemeris");
+        }
+    }
+
+    void
+    TopologySatelliteNetwork::BuildSatelliteEphemeris()
+    {
+
+        // Start time of each satellite
+        std::vector<JulianDate> starts;
+        for (uint32_t i = 0; i < m_satellites.size(); i++) {
+            starts.push_back(m_satelliteNodes.Get(i)->GetObject<SatelliteEphemerisMobilityModel>()->GetStartTime());
+        }
+
+        // Propagate all satellites over the entire simulation, in parallel
+        m_satelliteEphemeris = SatelliteEphemeris::Build(
+                m_satellites,
+                starts,
+                NanoSeconds(m_basicSimulation->GetSimulationEndTimeNs()),
+                NanoSeconds(m_satellite_ephemeris_interval_ns),
+                m_satellite_ephemeris_num_threads
+        );
+        AssignSatelliteEphemeris();
+
+    }
+
+    void
+    TopologySatelliteNetwork::LoadSatelliteEphemeris()
+    {
+
+        // Map the file generated beforehand (read-only, shared with other runs)
+        m_satelliteEphemeris = SatelliteEphemeris::Load(m_satellite_ephemeris_file);
+        if (m_satelliteEphemeris->GetNSatellites() != m_satellites.size()) {
+            throw std::runtime_error("Number of satellites in the ephemeris file does not match the TLEs");
+        }
+
+        // Each satellite must have been sampled from the same TLE
+        for (uint32_t i = 0; i < m_satellites.size(); i++) {
+            const std::pair<std::string, std::string>& tle = m_satelliteTles[i];
+            if (m_satelliteEphemeris->GetTleEpoch(i) != SatelliteEphemeris::ParseTleEpoch(tle.first)) {
+                throw std::runtime_error(
+                        "Satellite " + std::to_string(i) + " in the ephemeris file has TLE epoch "
+                        + format_string("%.8f", m_satelliteEphemeris->GetTleEpoch(i)) + ", but "
+                        + format_string("%.8f", SatelliteEphemeris::ParseTleEpoch(tle.first)) + " in the TLEs"
+                );
+            }
+            if (m_satelliteEphemeris->GetTleHash(i) != SatelliteEphemeris::HashTle(tle.first, tle.second)) {
+                throw std::runtime_error("Satellite " + std::to_string(i) + " in the ephemeris file was sampled from a different TLE");
+            }
+        }
+        int64_t covered_ns = (m_satelliteEphemeris->GetNSamples() - 1) * m_satelliteEphemeris->GetInterval().GetNanoSeconds();
+        if (covered_ns < m_basicSimulation->GetSimulationEndTimeNs()) {
+            throw std::runtime_error(
+                    "Ephemeris file only covers " + std::to_string(covered_ns) + " ns, but the simulation lasts "
+                    + std::to_string(m_basicSimulation->GetSimulationEndTimeNs()) + " ns"
+            );
+        }
+        std::cout << "  > Satellite ephemeris interval... " << m_satelliteEphemeris->GetInterval().GetNanoSeconds() << " ns" << std::endl;
+
+        AssignSatelliteEphemeris();
+
+    }
+
+    void
+    TopologySatelliteNetwork::AssignSatelliteEphemeris()
+    {
+
+        for (uint32_t i = 0; i < m_satellites.size(); i++) {
+            m_satelliteNodes.Get(i)->GetObject<SatelliteEphemerisMobilityModel>()->SetEphemeris(m_satelliteEphemeris, i);
+        }
+
+        // Accuracy of the interpolation
+        std::cout << "  > Satellite ephemeris samples... " << m_satelliteEphemeris->GetNSamples() << " per satellite" << std::endl;
+        std::cout << "  > Satellite ephemeris max. error... " << m_satelliteEphemeris->GetMaxErrorBound() << " m" << std::endl;
+
     }
 
     void
@@ -208,7 +385,8 @@ namespace ns3 {
             m_groundStations.push_back(gs);
 
             // Create the node
-            m_groundStationNodes.Create(1);
+            CreateNode(m_groundStationNodes, m_satelliteNodes.GetN() + gid);
+            m_max_ground_station_radius_m = std::max(m_max_ground_station_radius_m, cartesian_position.GetLength());
             if (m_groundStationNodes.GetN() != gid + 1) {
                 throw std::runtime_error("GID is not incremented each line");
             }
@@ -244,6 +422,28 @@ namespace ns3 {
         std::cout << "    >> ISL data rate........ " << m_isl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
         std::cout << "    >> ISL max queue size... " << m_isl_max_queue_size_pkts << " packets" << std::endl;
 
+        // Propagation delay predicted per ISL by a piecewise polynomial, instead of computed per packet
+        if (m_isl_delay_model_max_error_ns > 0) {
+            p2p_laser_helper.SetChannelAttribute("DelayModelMaxError", TimeValue(NanoSeconds(m_isl_delay_model_max_error_ns)));
+            p2p_laser_helper.SetChannelAttribute("DelayModelMaxSegment", TimeValue(NanoSeconds(m_isl_delay_model_max_segment_ns)));
+            std::cout << "    >> ISL delay model max. error..... " << m_isl_delay_model_max_error_ns << " ns" << std::endl;
+            std::cout << "    >> ISL delay model max. segment... " << m_isl_delay_model_max_segment_ns << " ns" << std::endl;
+        }
+
+        // ISLs between systems have as lookahead their lowest delay until the end of the simulation
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            p2p_laser_helper.SetLookaheadWindow(
+                    NanoSeconds(m_basicSimulation->GetSimulationEndTimeNs()),
+                    NanoSeconds(m_isl_lookahead_sample_interval_ns)
+            );
+            std::cout << "    >> ISL lookahead sample interval... " << m_isl_lookahead_sample_interval_ns << " ns" << std::endl;
+        }
+
+        // Packets are handed over to the receiving device without copy
+        if (m_channel_zero_copy) {
+            p2p_laser_helper.SetChannelAttribute("ZeroCopy", BooleanValue(true));
+        }
+
         // Traffic control helper
         TrafficControlHelper tch_isl;
         tch_isl.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxSize", QueueSizeValue(QueueSize("1p"))); // Will be removed later any case
@@ -286,8 +486,8 @@ namespace ns3 {
 
             // Utilization tracking
             if (m_enable_isl_utilization_tracking) {
-                netDevices.Get(0)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
-                netDevices.Get(1)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns);
+                netDevices.Get(0)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns, m_islUtilizationWriter, sat0_id, sat1_id);
+                netDevices.Get(1)->GetObject<PointToPointLaserNetDevice>()->EnableUtilizationTracking(m_isl_utilization_tracking_interval_ns, m_islUtilizationWriter, sat1_id, sat0_id);
 
                 m_islNetDevices.Add(netDevices.Get(0));
                 m_islFromTo.push_back(std::make_pair(sat0_id, sat1_id));
@@ -315,6 +515,25 @@ namespace ns3 {
         std::cout << "    >> GSL data rate........ " << m_gsl_data_rate_megabit_per_s << " Mbit/s" << std::endl;
         std::cout << "    >> GSL max queue size... " << m_gsl_max_queue_size_pkts << " packets" << std::endl;
 
+        // Propagation delay between a pair of GSL devices is computed at most once per quantum
+        if (m_gsl_delay_cache_quantum_ns > 0) {
+            gsl_helper.SetChannelAttribute("DelayCacheQuantum", TimeValue(NanoSeconds(m_gsl_delay_cache_quantum_ns)));
+            std::cout << "    >> GSL delay cache quantum... " << m_gsl_delay_cache_quantum_ns << " ns" << std::endl;
+        }
+
+        // Packets are handed over to the receiving device without copy
+        if (m_channel_zero_copy) {
+            gsl_helper.SetChannelAttribute("ZeroCopy", BooleanValue(true));
+        }
+
+        // In distributed mode, the lower bound of the GSL delay is the lookahead
+        Time gsl_lookahead = Seconds(0);
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            gsl_lookahead = GetGslLookahead();
+            gsl_helper.SetChannelAttribute("Delay", TimeValue(gsl_lookahead));
+            std::cout << "    >> GSL lookahead........ " << gsl_lookahead.GetNanoSeconds() << " ns" << std::endl;
+        }
+
         // Traffic control helper
         TrafficControlHelper tch_gsl;
         tch_gsl.SetRootQueueDisc("ns3::FifoQueueDisc", "MaxSize", QueueSizeValue(QueueSize("1p")));  // Will be removed later any case
@@ -353,8 +572,19 @@ namespace ns3 {
 
         // Create and install GSL network devices
         NetDeviceContainer devices = gsl_helper.Install(m_satelliteNodes, m_groundStationNodes, node_gsl_if_info);
+        if (devices.GetN() > 0) {
+            m_gslChannel = DynamicCast<GSLChannel>(devices.Get(0)->GetChannel());
+        }
+
+        // The distributed simulator only derives its lookahead from point-to-point channels
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            BoundDistributedLookahead(gsl_lookahead);
+        }
         std::cout << "    >> Finished install GSL interfaces (interfaces, network devices, one shared channel)" << std::endl;
 
+        // Utilization and queue tracking of the GSL interfaces
+        EnableGslTracking(devices);
+
         // Install queueing disciplines
         tch_gsl.Install(devices);
         std::cout << "    >> Finished installing traffic control layer qdisc which will be removed later" << std::endl;
@@ -441,44 +671,429 @@ namespace ns3 {
 
     }
 
+    void TopologySatelliteNetwork::AssignNodesToSystems() {
+        int64_t num_systems = m_basicSimulation->GetSystemsCount();
+
+        // Satellites (identifiers are orbit-major), with their position at the start
+        std::ifstream fs;
+        fs.open(m_satellite_network_dir + "/tles.txt");
+        NS_ABORT_MSG_UNLESS(fs.is_open(), "File tles.txt could not be opened");
+        std::string orbits_and_n_sats_per_orbit;
+        std::getline(fs, orbits_and_n_sats_per_orbit);
+        std::vector<std::string> res = split_string(orbits_and_n_sats_per_orbit, " ", 2);
+        int64_t num_orbits = parse_positive_int64(res[0]);
+        int64_t satellites_per_orbit = parse_positive_int64(res[1]);
+        int64_t num_satellites = num_orbits * satellites_per_orbit;
+        std::vector<Vector> satellite_positions;
+        std::string name, tle1, tle2;
+        while (std::getline(fs, name)) {
+            std::getline(fs, tle1);
+            std::getline(fs, tle2);
+            Ptr<Satellite> satellite = CreateObject<Satellite>();
+            satellite->SetTleInfo(tle1, tle2);
+            satellite_positions.push_back(satellite->GetPosition(satellite->GetTleEpoch()));
+        }
+        fs.close();
+        if ((int64_t) satellite_positions.size() != num_satellites) {
+            throw std::runtime_error("Number of satellites defined in the TLEs does not match");
+        }
+
+        // Ground station positions
+        std::vector<Vector> ground_station_positions;
+        fs.open(m_satellite_network_dir + "/ground_stations.txt");
+        NS_ABORT_MSG_UNLESS(fs.is_open(), "File ground_stations.txt could not be opened");
+        std::string line;
+        while (std::getline(fs, line)) {
+            res = split_string(line, ",", 8);
+            ground_station_positions.push_back(Vector(parse_double(res[5]), parse_double(res[6]), parse_double(res[7])));
+        }
+        fs.close();
+        int64_t num_ground_stations = ground_station_positions.size();
+
+        // Partition
+        std::vector<int64_t> assignment = PartitionNodesToSystems(
+                num_systems, num_orbits, satellites_per_orbit, satellite_positions, ground_station_positions
+        );
+        bool by_plane = num_orbits >= num_systems;
+        std::vector<int64_t> system_num_satellites(num_systems, 0);
+        std::vector<int64_t> system_num_ground_stations(num_systems, 0);
+        for (int64_t i = 0; i < num_satellites + num_ground_stations; i++) {
+            if (i < num_satellites) {
+                system_num_satellites[assignment[i]]++;
+            } else {
+                system_num_ground_stations[assignment[i]]++;
+            }
+        }
+
+        // ISLs which cross systems
+        std::vector<int64_t> system_num_cross_isls(num_systems, 0);
+        int64_t num_cross_isls = 0;
+        fs.open(m_satellite_network_dir + "/isls.txt");
+        NS_ABORT_MSG_UNLESS(fs.is_open(), "File isls.txt could not be opened");
+        while (std::getline(fs, line)) {
+            res = split_string(line, " ", 2);
+            int64_t system_id_0 = assignment.at(parse_positive_int64(res.at(0)));
+            int64_t system_id_1 = assignment.at(parse_positive_int64(res.at(1)));
+            if (system_id_0 != system_id_1) {
+                system_num_cross_isls[system_id_0]++;
+                system_num_cross_isls[system_id_1]++;
+                num_cross_isls++;
+            }
+        }
+        fs.close();
+
+        // Statistics
+        std::cout << "  > Automatic node-to-system-id assignment (" << (by_plane ? "whole orbital planes" : "single satellites") << ")" << std::endl;
+        for (int64_t i = 0; i < num_systems; i++) {
+            printf(
+                    "    >> System %" PRId64 ": %" PRId64 " satellites, %" PRId64 " ground stations, %" PRId64 " cross-system ISLs\n",
+                    i, system_num_satellites[i], system_num_ground_stations[i], system_num_cross_isls[i]
+            );
+        }
+        std::cout << "    >> Cross-system ISLs... " << num_cross_isls << std::endl;
+
+        // Log the assignment (in config format, such that it can be reused) and the statistics
+        if (m_basicSimulation->GetSystemId() == 0) {
+            FILE* file_assignment = fopen((m_basicSimulation->GetLogsDir() + "/distributed_node_system_id_assignment.txt").c_str(), "w+");
+            fprintf(file_assignment, "list(");
+            for (size_t i = 0; i < assignment.size(); i++) {
+                fprintf(file_assignment, i == 0 ? "%" PRId64 : ",%" PRId64, assignment[i]);
+            }
+            fprintf(file_assignment, ")\n");
+            fclose(file_assignment);
+            FILE* file_statistics_csv = fopen((m_basicSimulation->GetLogsDir() + "/distributed_system_statistics.csv").c_str(), "w+");
+            for (int64_t i = 0; i < num_systems; i++) {
+                fprintf(
+                        file_statistics_csv, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
+                        i, system_num_satellites[i], system_num_ground_stations[i], system_num_cross_isls[i]
+                );
+            }
+            fclose(file_statistics_csv);
+        }
+
+        m_basicSimulation->SetDistributedNodeSystemIdAssignment(assignment);
+    }
+
+    std::vector<int64_t> TopologySatelliteNetwork::PartitionNodesToSystems(
+            int64_t num_systems,
+            int64_t num_orbits,
+            int64_t satellites_per_orbit,
+            const std::vector<Vector>& satellite_positions,
+            const std::vector<Vector>& ground_station_positions
+    ) {
+        int64_t num_satellites = num_orbits * satellites_per_orbit;
+        int64_t num_ground_stations = ground_station_positions.size();
+        NS_ABORT_MSG_IF(num_systems <= 0, "There must be at least one system");
+        NS_ABORT_MSG_IF((int64_t) satellite_positions.size() != num_satellites, "Number of satellite positions does not match");
+
+        // Whole orbital planes (or single satellites if there are fewer planes than systems)
+        // are assigned in order to the systems, evenly. With the +Grid, ISLs then only cross
+        // systems at the boundaries between two systems' planes.
+        std::vector<int64_t> assignment(num_satellites + num_ground_stations);
+        bool by_plane = num_orbits >= num_systems;
+        int64_t num_units = by_plane ? num_orbits : num_satellites;
+        int64_t unit_size = by_plane ? satellites_per_orbit : 1;
+        for (int64_t sid = 0; sid < num_satellites; sid++) {
+            assignment[sid] = (sid / unit_size) * num_systems / num_units;
+        }
+
+        // Each ground station goes to the system of the satellite closest to it at the start,
+        // as that is where its first GSL leads to, unless that system already has its
+        // (even) share of ground stations, in which case it goes to the one with the fewest
+        int64_t ground_station_share = (num_ground_stations + num_systems - 1) / num_systems;
+        std::vector<int64_t> system_num_ground_stations(num_systems, 0);
+        for (int64_t gid = 0; gid < num_ground_stations; gid++) {
+            int64_t closest_sid = 0;
+            double closest_distance_m = std::numeric_limits<double>::max();
+            for (int64_t sid = 0; sid < num_satellites; sid++) {
+                double distance_m = CalculateDistance(ground_station_positions[gid], satellite_positions[sid]);
+                if (distance_m < closest_distance_m) {
+                    closest_distance_m = distance_m;
+                    closest_sid = sid;
+                }
+            }
+            int64_t system_id = assignment[closest_sid];
+            if (system_num_ground_stations[system_id] >= ground_station_share) {
+                system_id = std::min_element(system_num_ground_stations.begin(), system_num_ground_stations.end()) - system_num_ground_stations.begin();
+            }
+            assignment[num_satellites + gid] = system_id;
+            system_num_ground_stations[system_id]++;
+        }
+
+        return assignment;
+    }
+
+    void TopologySatelliteNetwork::CreateNode(NodeContainer& nodes, uint32_t node_id) {
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            const std::vector<int64_t>& assignment = m_basicSimulation->GetDistributedNodeSystemIdAssignment();
+            if (node_id >= assignment.size()) {
+                throw std::invalid_argument(format_string("Node %u has no node-to-system-id assignment", node_id));
+            }
+            nodes.Create(1, assignment.at(node_id));
+        } else {
+            nodes.Create(1);
+        }
+    }
+
+    double TopologySatelliteNetwork::GetPerigeeRadius(const std::string& tle2) {
+
+        // TLE line 2: eccentricity (columns 27-33, leading decimal point assumed)
+        // and mean motion in revolutions per day (columns 53-63)
+        if (tle2.size() < 63) {
+            throw std::invalid_argument("TLE line 2 is too short: " + tle2);
+        }
+        double eccentricity = parse_positive_double("0." + tle2.substr(26, 7));
+        double mean_motion_rad_per_s = parse_positive_double(trim(tle2.substr(52, 11))) * 2.0 * M_PI / 86400.0;
+
+        // Semi-major axis from Kepler's third law (WGS72 gravitational parameter, as SGP4)
+        const double mu_m3_per_s2 = 398600.8e9;
+        double semi_major_axis_m = std::cbrt(mu_m3_per_s2 / (mean_motion_rad_per_s * mean_motion_rad_per_s));
+        return semi_major_axis_m * (1.0 - eccentricity);
+
+    }
+
+    Time TopologySatelliteNetwork::GetGslLookahead() {
+
+        // A GSL spans at least the gap between the lowest satellite perigee and the highest
+        // ground station. The margin covers the deviation of SGP4 (e.g., drag and the
+        // short-periodic terms) from the mean Keplerian orbit.
+        double min_distance_m = 0.9 * (m_min_satellite_perigee_radius_m - m_max_ground_station_radius_m);
+        if (min_distance_m <= 0) {
+            throw std::runtime_error("GSL lookahead is not positive: satellites are not above the ground stations");
+        }
+        return NanoSeconds((int64_t) std::floor(min_distance_m / 299792458.0 * 1e9));
+
+    }
+
+    void TopologySatelliteNetwork::BoundDistributedLookahead(Time lookahead) {
+#ifdef NS3_MPI
+        Ptr<SimulatorImpl> impl = Simulator::GetImplementation();
+        Ptr<DistributedSimulatorImpl> distributedImpl = DynamicCast<DistributedSimulatorImpl>(impl);
+        if (distributedImpl) {
+            distributedImpl->BoundLookAhead(lookahead);
+        }
+
+        // The null-message simulator keeps a bundle of channels (with the lowest delay as
+        // lookahead) per neighboring system, which it only creates for point-to-point
+        // channels, as such the GSL channel is added to those of all other systems with a
+        // GSL device (the same on every system, as such the bundles are symmetric)
+        if (DynamicCast<NullMessageSimulatorImpl>(impl) && m_gslChannel) {
+            std::set<uint32_t> system_ids;
+            for (size_t i = 0; i < m_gslChannel->GetNDevices(); i++) {
+                system_ids.insert(m_gslChannel->GetDevice(i)->GetNode()->GetSystemId());
+            }
+            for (uint32_t system_id : system_ids) {
+                if (system_id != m_basicSimulation->GetSystemId()) {
+                    Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find(system_id);
+                    if (!bundle) {
+                        bundle = RemoteChannelBundleManager::Add(system_id);
+                    }
+                    bundle->AddChannel(m_gslChannel, lookahead);
+                }
+            }
+        }
+#else
+        NS_FATAL_ERROR("Can't use distributed simulator without MPI compiled in");
+#endif
+    }
+
+    std::string TopologySatelliteNetwork::GetGslTrackingFilename(std::string name) {
+        if (m_basicSimulation->IsDistributedEnabled()) {
+            return m_basicSimulation->GetLogsDir() + "/system_" + std::to_string(m_basicSimulation->GetSystemId()) + "_" + name;
+        } else {
+            return m_basicSimulation->GetLogsDir() + "/" + name;
+        }
+    }
+
+    void TopologySatelliteNetwork::EnableGslTracking(const NetDeviceContainer& devices) {
+        if (!m_enable_gsl_utilization_tracking && !m_enable_gsl_queue_tracking) {
+            return;
+        }
+
+        // For which satellites and ground stations (by satellite id and ground station id)
+        std::string enable_for_satellites_str = m_basicSimulation->GetConfigParamOrDefault("gsl_tracking_enable_for_satellites", "all");
+        std::string enable_for_ground_stations_str = m_basicSimulation->GetConfigParamOrDefault("gsl_tracking_enable_for_ground_stations", "all");
+        std::set<int64_t> enable_for_satellites;
+        std::set<int64_t> enable_for_ground_stations;
+        if (enable_for_satellites_str != "all") {
+            enable_for_satellites = parse_set_positive_int64(enable_for_satellites_str);
+            for (int64_t sat_id : enable_for_satellites) {
+                if (sat_id >= (int64_t) m_satelliteNodes.GetN()) {
+                    throw std::invalid_argument(format_string("GSL tracking satellite id %" PRId64 " does not exist", sat_id));
+                }
+            }
+        }
+        if (enable_for_ground_stations_str != "all") {
+            enable_for_ground_stations = parse_set_positive_int64(enable_for_ground_stations_str);
+            for (int64_t gs_id : enable_for_ground_stations) {
+                if (gs_id >= (int64_t) m_groundStationNodes.GetN()) {
+                    throw std::invalid_argument(format_string("GSL tracking ground station id %" PRId64 " does not exist", gs_id));
+                }
+            }
+        }
+
+        // Completed utilization runs can be streamed instead of kept in memory
+        if (m_enable_gsl_utilization_tracking) {
+            std::cout << "    >> GSL utilization tracking interval... " << m_gsl_utilization_tracking_interval_ns << " ns" << std::endl;
+            if (parse_boolean(m_basicSimulation->GetConfigParamOrDefault("gsl_utilization_tracking_streaming", "false"))) {
+                m_gslUtilizationWriter = Create<UtilizationRunWriter>(GetGslTrackingFilename("gsl_utilization.csv"), 1 << 20);
+            }
+        }
+
+        // Enable on the selected interfaces of the nodes of this system
+        std::vector<int64_t> node_gsl_if_counter(m_allNodes.GetN(), 0);
+        for (uint32_t i = 0; i < devices.GetN(); i++) {
+            Ptr<GSLNetDevice> dev = devices.Get(i)->GetObject<GSLNetDevice>();
+            int64_t node_id = dev->GetNode()->GetId();
+            int64_t gsl_if_id = node_gsl_if_counter[node_id]++;
+            bool selected;
+            if (IsSatelliteId(node_id)) {
+                selected = enable_for_satellites_str == "all" || enable_for_satellites.count(node_id) > 0;
+            } else {
+                selected = enable_for_ground_stations_str == "all" || enable_for_ground_stations.count(NodeToGroundStationId(node_id)) > 0;
+            }
+            if (!selected || (m_basicSimulation->IsDistributedEnabled() && !m_basicSimulation->IsNodeAssignedToThisSystem(node_id))) {
+                continue;
+            }
+            if (m_enable_gsl_utilization_tracking) {
+                dev->EnableUtilizationTracking(m_gsl_utilization_tracking_interval_ns, m_gslUtilizationWriter, node_id, gsl_if_id);
+            }
+            if (m_enable_gsl_queue_tracking) {
+                dev->EnableQueueTracking();
+            }
+            m_gslNetDevices.Add(dev);
+            m_gslNodeIfIds.push_back(std::make_pair(node_id, gsl_if_id));
+        }
+        std::cout << "    >> Tracking " << (m_enable_gsl_utilization_tracking ? "utilization " : "")
+                  << (m_enable_gsl_queue_tracking ? "queue " : "") << "on " << m_gslNetDevices.GetN() << " GSL interfaces" << std::endl;
+
+    }
+
     void TopologySatelliteNetwork::CollectUtilizationStatistics() {
         if (m_enable_isl_utilization_tracking) {
 
+            // When streaming, the devices only have their last run left to write
+            if (m_islUtilizationWriter) {
+                for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
+                    m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>()->FinalizeUtilization();
+                }
+                m_islUtilizationWriter->Close();
+                return;
+            }
+
             // Open CSV file
             FILE* file_utilization_csv = fopen((m_basicSimulation->GetLogsDir() + "/isl_utilization.csv").c_str(), "w+");
 
             // Go over every ISL network device
             for (size_t i = 0; i < m_islNetDevices.GetN(); i++) {
                 Ptr<PointToPointLaserNetDevice> dev = m_islNetDevices.Get(i)->GetObject<PointToPointLaserNetDevice>();
-                const std::vector<double> utilization = dev->FinalizeUtilization();
+                const std::vector<UtilizationRun>& runs = dev->FinalizeUtilization();
                 std::pair<int32_t, int32_t> src_dst = m_islFromTo[i];
-                int64_t interval_left_side_ns = 0;
-                for (size_t j = 0; j < utilization.size(); j++) {
+                for (const UtilizationRun& run : runs) {
+
+                    // Write plain to the CSV file:
+                    // <src>,<dst>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
+                    fprintf(file_utilization_csv,
+                            "%d,%d,%" PRId64 ",%" PRId64 ",%f\n",
+                            src_dst.first,
+                            src_dst.second,
+                            run.start_ns,
+                            run.end_ns,
+                            run.utilization
+                    );
+
+                }
+            }
 
-                    // Only write if it is the last one, or if the utilization is different from the next
-                    if (j == utilization.size() - 1 || utilization[j] != utilization[j + 1]) {
+            // Close CSV file
+            fclose(file_utilization_csv);
+
+        }
+
+        // GSL utilization
+        if (m_enable_gsl_utilization_tracking) {
+            if (m_gslUtilizationWriter) {
+                for (size_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+                    m_gslNetDevices.Get(i)->GetObject<GSLNetDevice>()->FinalizeUtilization();
+                }
+                m_gslUtilizationWriter->Close();
+            } else {
+                FILE* file_gsl_utilization_csv = fopen(GetGslTrackingFilename("gsl_utilization.csv").c_str(), "w+");
+                for (size_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+                    const std::vector<UtilizationRun>& runs = m_gslNetDevices.Get(i)->GetObject<GSLNetDevice>()->FinalizeUtilization();
+                    for (const UtilizationRun& run : runs) {
 
                         // Write plain to the CSV file:
-                        // <src>,<dst>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
-                        fprintf(file_utilization_csv,
-                                "%d,%d,%" PRId64 ",%" PRId64 ",%f\n",
-                                src_dst.first,
-                                src_dst.second,
-                                interval_left_side_ns,
-                                (j + 1) * m_isl_utilization_tracking_interval_ns,
-                                utilization[j]
+                        // <node id>,<gsl if id>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
+                        fprintf(file_gsl_utilization_csv,
+                                "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%f\n",
+                                m_gslNodeIfIds[i].first,
+                                m_gslNodeIfIds[i].second,
+                                run.start_ns,
+                                run.end_ns,
+                                run.utilization
                         );
 
-                        interval_left_side_ns = (j + 1) * m_isl_utilization_tracking_interval_ns;
-
                     }
                 }
+                fclose(file_gsl_utilization_csv);
+            }
+        }
+
+        // GSL queue
+        if (m_enable_gsl_queue_tracking) {
+            FILE* file_gsl_queue_csv = fopen(GetGslTrackingFilename("gsl_queue.csv").c_str(), "w+");
+            for (size_t i = 0; i < m_gslNetDevices.GetN(); i++) {
+                const std::vector<std::tuple<int64_t, int64_t, int64_t>>& log_entries = m_gslNetDevices.Get(i)->GetObject<GSLNetDevice>()->FinalizeQueueTracking();
+                for (const std::tuple<int64_t, int64_t, int64_t>& entry : log_entries) {
+
+                    // Write plain to the CSV file:
+                    // <node id>,<gsl if id>,<interval start (ns)>,<interval end (ns)>,<number of packets>
+                    fprintf(file_gsl_queue_csv,
+                            "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 "\n",
+                            m_gslNodeIfIds[i].first,
+                            m_gslNodeIfIds[i].second,
+                            std::get<0>(entry),
+                            std::get<1>(entry),
+                            std::get<2>(entry)
+                    );
+
+                }
+            }
+            fclose(file_gsl_queue_csv);
+        }
+
+    }
+
+    void TopologySatelliteNetwork::CollectCacheStatistics() {
+        bool gsl_delay_cache = m_gslChannel && m_gsl_delay_cache_quantum_ns > 0;
+        if (m_satellitePositionCache || gsl_delay_cache) {
+
+            // Open CSV file
+            FILE* file_cache_csv = fopen((m_basicSimulation->GetLogsDir() + "/cache_statistics.csv").c_str(), "w+");
+
+            // Write plain to the CSV file:
+            // <cache>,<hits>,<misses>
+            if (m_satellitePositionCache) {
+                WriteCacheStatistics(file_cache_csv, "satellite_position", "Satellite position cache", m_satellitePositionCache->GetHits(), m_satellitePositionCache->GetMisses());
+            }
+            if (gsl_delay_cache) {
+                WriteCacheStatistics(file_cache_csv, "gsl_delay", "GSL delay cache", m_gslChannel->GetDelayCacheHits(), m_gslChannel->GetDelayCacheMisses());
             }
 
             // Close CSV file
-            fclose(file_utilization_csv);
+            fclose(file_cache_csv);
+
+        }
+    }
 
+    void TopologySatelliteNetwork::WriteCacheStatistics(FILE* file_cache_csv, std::string cache, std::string label, uint64_t hits, uint64_t misses) {
+        fprintf(file_cache_csv, "%s,%" PRIu64 ",%" PRIu64 "\n", cache.c_str(), hits, misses);
+        std::cout << label << ": " << hits << " hits, " << misses << " misses";
+        if (hits + misses > 0) {
+            printf(" (hit rate %.2f%%)", 100.0 * hits / (hits + misses));
         }
+        std::cout << std::endl;
     }
 
     uint32_t TopologySatelliteNetwork::GetNumSatellites() {
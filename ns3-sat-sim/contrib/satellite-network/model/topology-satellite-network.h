@@ -23,6 +23,9 @@
 #define TOPOLOGY_SATELLITE_NETWORK_H
 
 #include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "ns3/core-module.h"
 #include "ns3/node.h"
 #include "ns3/node-container.h"
@@ -38,6 +41,9 @@
 #include "ns3/command-line.h"
 #include "ns3/traffic-control-helper.h"
 #include "ns3/ground-station.h"
+#include "ns3/satellite-ephemeris.h"
+#include "ns3/satellite-ephemeris-mobility-model.h"
+#include "ns3/satellite-position-cache.h"
 #include "ns3/satellite-position-helper.h"
 #include "ns3/satellite-position-mobility-model.h"
 #include "ns3/mobility-helper.h"
@@ -47,6 +53,8 @@
 #include "ns3/satellite-position-helper.h"
 #include "ns3/point-to-point-laser-helper.h"
 #include "ns3/gsl-helper.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/gsl-net-device.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/mobility-model.h"
 #include "ns3/ipv4-static-routing-helper.h"
@@ -54,7 +62,14 @@
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/point-to-point-laser-net-device.h"
+#include "ns3/utilization-run-writer.h"
 #include "ns3/ipv4.h"
+#ifdef NS3_MPI
+#include "ns3/distributed-simulator-impl.h"
+#include "ns3/null-message-simulator-impl.h"
+#include "ns3/remote-channel-bundle.h"
+#include "ns3/remote-channel-bundle-manager.h"
+#endif
 
 namespace ns3 {
 
@@ -86,6 +101,22 @@ namespace ns3 {
 
         // Post-processing
         void CollectUtilizationStatistics();
+        void CollectCacheStatistics();
+
+        // Node-to-system-id assignment: whole orbital planes go in order to the systems, and
+        // each ground station to the system of its closest satellite (capped at an even share)
+        static std::vector<int64_t> PartitionNodesToSystems(
+                int64_t num_systems,
+                int64_t num_orbits,
+                int64_t satellites_per_orbit,
+                const std::vector<Vector>& satellite_positions,
+                const std::vector<Vector>& ground_station_positions
+        );
+
+        // Lookahead of the distributed simulator: the lower bound of the GSL delay (throws if the satellites
+        // are not above the ground stations), and bounding the lookahead of the distributed simulator by it
+        Time GetGslLookahead();
+        void BoundDistributedLookahead(Time lookahead);
 
     private:
 
@@ -94,9 +125,18 @@ namespace ns3 {
         void Build(const Ipv4RoutingHelper& ipv4RoutingHelper);
         void ReadGroundStations();
         void ReadSatellites();
+        void BuildSatelliteEphemeris();
+        void LoadSatelliteEphemeris();
+        void AssignSatelliteEphemeris();
         void InstallInternetStacks(const Ipv4RoutingHelper& ipv4RoutingHelper);
         void ReadISLs();
         void CreateGSLs();
+        void AssignNodesToSystems();
+        void CreateNode(NodeContainer& nodes, uint32_t node_id);
+        double GetPerigeeRadius(const std::string& tle2);
+        void EnableGslTracking(const NetDeviceContainer& devices);
+        std::string GetGslTrackingFilename(std::string name);
+        void WriteCacheStatistics(FILE* file_cache_csv, std::string cache, std::string label, uint64_t hits, uint64_t misses);
 
         // Helper
         void EnsureValidNodeId(uint32_t node_id);
@@ -111,6 +151,16 @@ namespace ns3 {
         std::string m_satellite_network_routes_dir;   //<! Directory containing the routes over time of the network
         bool m_satellite_network_force_static;        //<! True to disable satellite movement and basically run
                                                       //   it static at t=0 (like a static network)
+        int64_t m_satellite_position_cache_quantum_ns; //<! Satellites are propagated at most once per quantum (0 = no cache)
+        std::string m_satellite_mobility_model;       //<! Satellite mobility model: "sgp4" (exact) or "ephemeris" (interpolated)
+        int64_t m_satellite_ephemeris_interval_ns;    //<! Interval between two ephemeris samples (ephemeris model only)
+        int64_t m_satellite_ephemeris_num_threads;    //<! Threads used to build the ephemeris (0 = number of cores)
+        std::string m_satellite_ephemeris_file;       //<! Pre-generated ephemeris file to map instead of propagating ("" = none)
+        bool m_channel_zero_copy;                     //<! True to hand packets from ISL/GSL channels to the receiving device without copy
+        int64_t m_gsl_delay_cache_quantum_ns;         //<! GSL delay per device pair is computed at most once per quantum (0 = no cache)
+        int64_t m_isl_delay_model_max_error_ns;       //<! Maximum error of the predicted ISL delay (0 = exact per packet)
+        int64_t m_isl_delay_model_max_segment_ns;     //<! Maximum time span of one polynomial of the predicted ISL delay
+        int64_t m_isl_lookahead_sample_interval_ns;   //<! Interval at which ISLs between systems are sampled for their lookahead
 
         // Generated state
         NodeContainer m_allNodes;                           //!< All nodes
@@ -118,7 +168,15 @@ namespace ns3 {
         NodeContainer m_satelliteNodes;                     //!< Satellite nodes
         std::vector<Ptr<GroundStation> > m_groundStations;  //!< Ground stations
         std::vector<Ptr<Satellite>> m_satellites;           //<! Satellites
+        std::vector<std::pair<std::string, std::string>> m_satelliteTles; //<! TLE lines of each satellite (only kept to check a loaded ephemeris)
         std::set<int64_t> m_endpoints;                      //<! Endpoint ids = ground station ids
+        Ptr<SatellitePositionCache> m_satellitePositionCache; //<! Position cache shared by all satellites (can be 0)
+        Ptr<SatelliteEphemeris> m_satelliteEphemeris;       //<! Ephemeris shared by all satellites (can be 0)
+        double m_min_satellite_perigee_radius_m;            //<! Lowest perigee (distance to Earth center) of all satellites
+        double m_max_ground_station_radius_m;               //<! Highest ground station (distance to Earth center)
+
+        // GSL channel (shared by all GSL devices)
+        Ptr<GSLChannel> m_gslChannel;
 
         // ISL devices
         NetDeviceContainer m_islNetDevices;
@@ -131,6 +189,15 @@ namespace ns3 {
         int64_t m_gsl_max_queue_size_pkts;
         bool m_enable_isl_utilization_tracking;
         int64_t m_isl_utilization_tracking_interval_ns;
+        Ptr<UtilizationRunWriter> m_islUtilizationWriter;  //<! Streams completed ISL utilization runs (can be 0)
+
+        // GSL devices with utilization and/or queue tracking
+        NetDeviceContainer m_gslNetDevices;
+        std::vector<std::pair<int64_t, int64_t>> m_gslNodeIfIds;  //<! (node id, GSL interface index on the node)
+        bool m_enable_gsl_utilization_tracking;
+        int64_t m_gsl_utilization_tracking_interval_ns;
+        bool m_enable_gsl_queue_tracking;
+        Ptr<UtilizationRunWriter> m_gslUtilizationWriter;  //<! Streams completed GSL utilization runs (can be 0)
 
     };
 
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "utilization-run-writer.h"
+
+#include <cinttypes>
+#include <stdexcept>
+
+namespace ns3 {
+
+UtilizationRunWriter::UtilizationRunWriter(std::string filename, size_t buffer_size_byte) {
+    m_file = fopen(filename.c_str(), "w+");
+    if (m_file == nullptr) {
+        throw std::runtime_error("File " + filename + " could not be opened for writing");
+    }
+    m_buffer.resize(buffer_size_byte);
+    setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+}
+
+UtilizationRunWriter::~UtilizationRunWriter() {
+    Close();
+}
+
+void UtilizationRunWriter::WriteRun(const std::string& line_prefix, const UtilizationRun& run) {
+    if (m_file == nullptr) {
+        throw std::runtime_error("Cannot write a utilization run after the writer has been closed");
+    }
+    fprintf(m_file,
+            "%s,%" PRId64 ",%" PRId64 ",%f\n",
+            line_prefix.c_str(),
+            run.start_ns,
+            run.end_ns,
+            run.utilization
+    );
+}
+
+void UtilizationRunWriter::Close() {
+    if (m_file != nullptr) {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef UTILIZATION_RUN_WRITER_H
+#define UTILIZATION_RUN_WRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+/**
+ * A run of consecutive tracking intervals which all had the same utilization.
+ */
+struct UtilizationRun {
+    int64_t start_ns;    //!< Start of the first interval of the run (inclusive)
+    int64_t end_ns;      //!< End of the last interval of the run (exclusive)
+    double utilization;  //!< Utilization (0.0-1.0) of every interval in the run
+};
+
+/**
+ * Writes completed utilization runs of many network devices to a single CSV file,
+ * one line per run, starting with the line prefix which identifies the device:
+ *
+ *   <line prefix>,<interval start (ns)>,<interval end (ns)>,<utilization 0.0-1.0>
+ *
+ * The file is written through a large user-space buffer, such that the many small
+ * writes of the devices (which each write a run as soon as it is complete) do not
+ * each become a system call. Lines of different devices are interleaved.
+ */
+class UtilizationRunWriter : public SimpleRefCount<UtilizationRunWriter> {
+
+public:
+    UtilizationRunWriter(std::string filename, size_t buffer_size_byte);
+    ~UtilizationRunWriter();
+    void WriteRun(const std::string& line_prefix, const UtilizationRun& run);
+    void Close();
+
+private:
+    FILE* m_file;
+    std::vector<char> m_buffer;
+
+};
+
+}
+
+#endif //UTILIZATION_RUN_WRITER_H
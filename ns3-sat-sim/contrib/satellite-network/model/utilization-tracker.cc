@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "utilization-tracker.h"
+
+#include "ns3/simulator.h"
+#include "ns3/abort.h"
+
+namespace ns3 {
+
+void
+UtilizationTracker::Enable(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, std::string line_prefix) {
+    m_enabled = true;
+    m_interval_ns = interval_ns;
+    m_prev_time_ns = 0;
+    m_current_interval_start = 0;
+    m_current_interval_end = m_interval_ns;
+    m_idle_time_counter_ns = 0;
+    m_busy_time_counter_ns = 0;
+    m_current_state_is_on = false;
+    m_runs.clear();
+    m_writer = writer;
+    m_line_prefix = line_prefix;
+}
+
+void
+UtilizationTracker::AddUtilizationInterval(double utilization) {
+
+    // Same utilization as the open run: extend it
+    if (!m_runs.empty() && m_runs.back().utilization == utilization) {
+        m_runs.back().end_ns = m_current_interval_end;
+        return;
+    }
+
+    // The open run is complete, when streaming it no longer needs to be kept
+    if (m_writer && !m_runs.empty()) {
+        m_writer->WriteRun(m_line_prefix, m_runs.back());
+        m_runs.clear();
+    }
+    m_runs.push_back({m_current_interval_start, m_current_interval_end, utilization});
+
+}
+
+void
+UtilizationTracker::TrackUtilization(bool next_state_is_on) {
+    if (m_enabled) {
+
+        // Current time in nanoseconds
+        int64_t now_ns = Simulator::Now().GetNanoSeconds();
+        while (now_ns >= m_current_interval_end) {
+
+            // Add everything until the end of the interval
+            if (next_state_is_on) {
+                m_idle_time_counter_ns += m_current_interval_end - m_prev_time_ns;
+            } else {
+                m_busy_time_counter_ns += m_current_interval_end - m_prev_time_ns;
+            }
+
+            // Save into the utilization runs
+            AddUtilizationInterval(((double) m_busy_time_counter_ns) / ((double) m_interval_ns));
+
+            // This must match up
+            NS_ABORT_MSG_IF(m_idle_time_counter_ns + m_busy_time_counter_ns != m_interval_ns, "Not all time is accounted for");
+
+            // Move to next interval
+            m_idle_time_counter_ns = 0;
+            m_busy_time_counter_ns = 0;
+            m_prev_time_ns = m_current_interval_end;
+            m_current_interval_start += m_interval_ns;
+            m_current_interval_end += m_interval_ns;
+        }
+
+        // If not at the end of a new interval, just keep track of it all
+        if (next_state_is_on) {
+            m_idle_time_counter_ns += now_ns - m_prev_time_ns;
+        } else {
+            m_busy_time_counter_ns += now_ns - m_prev_time_ns;
+        }
+
+        // This has become the previous call
+        m_current_state_is_on = next_state_is_on;
+        m_prev_time_ns = now_ns;
+
+    }
+}
+
+const std::vector<UtilizationRun>&
+UtilizationTracker::Finalize() {
+    TrackUtilization(!m_current_state_is_on);
+
+    // When streaming, the open run is the last one to write
+    if (m_writer && !m_runs.empty()) {
+        m_writer->WriteRun(m_line_prefix, m_runs.back());
+        m_runs.clear();
+    }
+
+    return m_runs;
+}
+
+}
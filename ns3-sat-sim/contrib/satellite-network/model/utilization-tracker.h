@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef UTILIZATION_TRACKER_H
+#define UTILIZATION_TRACKER_H
+
+#include <string>
+#include <vector>
+#include "ns3/ptr.h"
+#include "utilization-run-writer.h"
+
+namespace ns3 {
+
+/**
+ * Tracks the utilization of a network device over fixed-size intervals, from
+ * the moments its transmitter turns on (busy) and off (idle). Consecutive
+ * intervals with the same utilization are kept as a single run. If a writer
+ * is given, completed runs are streamed to it, such that only the open run
+ * is kept in memory.
+ */
+class UtilizationTracker {
+
+public:
+    void Enable(int64_t interval_ns, Ptr<UtilizationRunWriter> writer, std::string line_prefix);
+    void TrackUtilization(bool next_state_is_on);
+    const std::vector<UtilizationRun>& Finalize();
+
+private:
+    bool m_enabled = false;
+    int64_t m_interval_ns;
+    int64_t m_prev_time_ns;
+    int64_t m_current_interval_start;
+    int64_t m_current_interval_end;
+    int64_t m_idle_time_counter_ns;
+    int64_t m_busy_time_counter_ns;
+    bool m_current_state_is_on;
+    std::vector<UtilizationRun> m_runs;   // Completed runs (if not streamed) followed by the open run
+    Ptr<UtilizationRunWriter> m_writer;   // If set, completed runs are streamed to it instead
+    std::string m_line_prefix;            // Identifies the device in the lines of the streamed runs
+    void AddUtilizationInterval(double utilization);
+
+};
+
+}
+
+#endif //UTILIZATION_TRACKER_H
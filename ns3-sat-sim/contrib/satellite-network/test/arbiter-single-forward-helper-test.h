@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterSingleForwardHelperBinaryTestCase : public TestCase {
+public:
+    ArbiterSingleForwardHelperBinaryTestCase () : TestCase ("arbiter-single-forward-helper binary") {};
+
+    const std::string temp_dir = ".tmp-arbiter-single-forward-helper-binary-test";
+
+    // Forwarding state at t=0 (same topology as the end-to-end-special test), one record per line
+    const std::vector<std::vector<int32_t>> records = {
+        {3, 5, 0, 0, 1},
+        {0, 5, 1, 0, 0},
+        {1, 5, 5, 1, 0},
+        {3, 6, 1, 1, 1},
+        {1, 6, 6, 2, 0},
+        {4, 5, 1, 0, 1},
+        {4, 6, 2, 0, 0},
+        {2, 6, 6, 0, 0},
+        {5, 3, -1, -1, -1}
+    };
+
+    // Topology
+    //
+    // Satellites:               0 ----- 1        2
+    //                          ||       ||       |
+    //                   ( ......... GSL channel ......... )
+    //                    ||    |               |    |
+    // Ground stations:   3     4               5    6
+    void PrepareRunDir() {
+        mkdir_if_not_exists(temp_dir);
+        mkdir_if_not_exists(temp_dir + "/dynamic_state");
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl; // 1477
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl; // 1499
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl; // 1543
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+
+        // Text forwarding state
+        std::ofstream fstate_file;
+        fstate_file.open (temp_dir + "/dynamic_state/fstate_0.txt");
+        for (const std::vector<int32_t>& record : records) {
+            fstate_file << record[0] << "," << record[1] << "," << record[2] << "," << record[3] << "," << record[4] << std::endl;
+        }
+        fstate_file.close();
+
+    }
+
+    void WriteConfig(bool binary) {
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=100000000" << std::endl; // Only the state at t=0
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "satellite_network_routes_binary=" << (binary ? "true" : "false") << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file.close();
+    }
+
+    // Binary forwarding state, of which the header and size can be altered
+    void WriteBinaryForwardingState(const char* magic, uint32_t version, uint64_t num_records, size_t num_records_written, size_t num_trailing_bytes) {
+        std::ofstream bin_file(temp_dir + "/dynamic_state/fstate_0.bin", std::ios::binary);
+        uint32_t values_per_record = 5;
+        bin_file.write(magic, 8);
+        bin_file.write((const char*) &version, sizeof(uint32_t));
+        bin_file.write((const char*) &values_per_record, sizeof(uint32_t));
+        bin_file.write((const char*) &num_records, sizeof(uint64_t));
+        for (size_t i = 0; i < num_records_written; i++) {
+            bin_file.write((const char*) records[i].data(), 5 * sizeof(int32_t));
+        }
+        for (size_t i = 0; i < num_trailing_bytes; i++) {
+            bin_file.put(0);
+        }
+        bin_file.close();
+    }
+
+    // Loads the forwarding state at t=0, which fills in the representation of every node's
+    // state (if it succeeded), and returns whether loading threw an exception
+    bool Load(bool binary, std::vector<std::string>& state_repr) {
+        WriteConfig(binary);
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        bool thrown = false;
+        try {
+            ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
+            for (uint32_t i = 0; i < topology->GetNodes().GetN(); i++) {
+                state_repr.push_back(topology->GetNodes().Get(i)->GetObject<Ipv4>()->GetRoutingProtocol()->GetObject<Ipv4ArbiterRouting>()->GetArbiter()->StringReprOfForwardingState());
+            }
+        } catch (std::exception& e) {
+            thrown = true;
+        }
+        basicSimulation->Finalize();
+        return thrown;
+    }
+
+    void DoRun () {
+        PrepareRunDir();
+        size_t n = records.size();
+
+        // Text
+        std::vector<std::string> state_text;
+        ASSERT_FALSE(Load(false, state_text));
+        ASSERT_EQUAL(state_text.size(), 7);
+
+        // Binary results in exactly the same state
+        std::vector<std::string> state_binary;
+        WriteBinaryForwardingState("SATFSTAT", 1, n, n, 0);
+        ASSERT_FALSE(Load(true, state_binary));
+        ASSERT_TRUE(state_text == state_binary);
+
+        // Bad magic
+        std::vector<std::string> state_ignored;
+        WriteBinaryForwardingState("SATFSTAX", 1, n, n, 0);
+        ASSERT_TRUE(Load(true, state_ignored));
+
+        // Wrong version
+        WriteBinaryForwardingState("SATFSTAT", 2, n, n, 0);
+        ASSERT_TRUE(Load(true, state_ignored));
+
+        // Truncated: a record is missing, or only a part of the last record is there
+        WriteBinaryForwardingState("SATFSTAT", 1, n, n - 1, 0);
+        ASSERT_TRUE(Load(true, state_ignored));
+        WriteBinaryForwardingState("SATFSTAT", 1, n, n - 1, 12);
+        ASSERT_TRUE(Load(true, state_ignored));
+
+        // Trailing bytes: part of a record, or a whole record more than the header says
+        WriteBinaryForwardingState("SATFSTAT", 1, n, n, 1);
+        ASSERT_TRUE(Load(true, state_ignored));
+        WriteBinaryForwardingState("SATFSTAT", 1, n - 1, n, 0);
+        ASSERT_TRUE(Load(true, state_ignored));
+
+        // Header claims far more records than the file holds (rejected before allocating)
+        WriteBinaryForwardingState("SATFSTAT", 1, ((uint64_t) 1) << 60, n, 0);
+        ASSERT_TRUE(Load(true, state_ignored));
+        ASSERT_EQUAL(state_ignored.size(), 0);
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
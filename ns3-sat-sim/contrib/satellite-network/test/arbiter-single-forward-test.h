@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/single-forward-table.h"
+#include "ns3/arbiter-single-forward.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ArbiterSingleForwardTableTestCase : public TestCase {
+public:
+    ArbiterSingleForwardTableTestCase () : TestCase ("arbiter-single-forward table") {};
+
+    void DoRun () {
+
+        // Line of four nodes: 0 -- 1 -- 2 -- 3, each link its own /24 subnet
+        NodeContainer nodes;
+        nodes.Create(4);
+        InternetStackHelper internet;
+        internet.Install(nodes);
+        PointToPointHelper p2p;
+        Ipv4AddressHelper address;
+        address.SetBase("10.0.0.0", "255.255.255.0");
+        for (uint32_t i = 0; i < 3; i++) {
+            address.Assign(p2p.Install(nodes.Get(i), nodes.Get(i + 1)));
+            address.NewNetwork();
+        }
+
+        // Only nodes 3 and 1 are destinations, they get a column in ascending order
+        std::set<int64_t> destinations = {3, 1};
+        Ptr<SingleForwardTable> table = Create<SingleForwardTable>(4, destinations);
+        ASSERT_EQUAL(table->GetNumNodes(), 4);
+        ASSERT_EQUAL(table->GetDestinations().size(), 2);
+        ASSERT_EQUAL(table->GetDestinations()[0], 1);
+        ASSERT_EQUAL(table->GetDestinations()[1], 3);
+        ASSERT_EQUAL(table->GetColumn(0), -1);
+        ASSERT_EQUAL(table->GetColumn(1), 0);
+        ASSERT_EQUAL(table->GetColumn(2), -1);
+        ASSERT_EQUAL(table->GetColumn(3), 1);
+        ASSERT_EQUAL(table->GetSizeByte(), 4 * 2 * 8 + 4 * 2 * 4 + 4 * 4 + 2 * 8);
+        ASSERT_EXCEPTION(Create<SingleForwardTable>(4, std::set<int64_t>({4})));
+
+        // Every entry starts out invalid
+        for (int64_t node_id = 0; node_id < 4; node_id++) {
+            for (int32_t column = 0; column < 2; column++) {
+                ASSERT_EQUAL(table->GetRow(node_id)[column].next_node_id, -2);
+                ASSERT_EQUAL(table->GetRow(node_id)[column].own_if_id, -2);
+                ASSERT_EQUAL(table->GetRow(node_id)[column].next_if_id, -2);
+                ASSERT_EQUAL(table->GetGatewayRow(node_id)[column], 0);
+            }
+        }
+
+        // One arbiter per node, all on the same table
+        std::vector<Ptr<ArbiterSingleForward>> arbiters;
+        for (uint32_t i = 0; i < 4; i++) {
+            arbiters.push_back(CreateObject<ArbiterSingleForward>(nodes.Get(i), nodes, table));
+        }
+        Ptr<Packet> p = Create<Packet>(100);
+        Ipv4Header ipHeader;
+
+        // Invalid: not set yet, or not a destination at all
+        std::tuple<int32_t, int32_t, int32_t> invalid = std::make_tuple(-2, -2, -2);
+        ASSERT_TRUE(arbiters[0]->TopologySatelliteNetworkDecide(0, 3, p, ipHeader, false) == invalid);
+        ASSERT_TRUE(arbiters[0]->TopologySatelliteNetworkDecide(0, 2, p, ipHeader, false) == invalid);
+
+        // Next hops towards node 3 are written into the column of node 3 of each node's own row
+        arbiters[0]->SetSingleForwardState(3, 1, 1, 1);
+        arbiters[1]->SetSingleForwardState(3, 2, 2, 1);
+        arbiters[2]->SetSingleForwardState(3, 3, 2, 1);
+        ASSERT_TRUE(arbiters[0]->TopologySatelliteNetworkDecide(0, 3, p, ipHeader, false) == std::make_tuple(1, 1, 1));
+        ASSERT_TRUE(arbiters[1]->TopologySatelliteNetworkDecide(0, 3, p, ipHeader, false) == std::make_tuple(2, 2, 1));
+        ASSERT_TRUE(arbiters[2]->TopologySatelliteNetworkDecide(0, 3, p, ipHeader, false) == std::make_tuple(3, 2, 1));
+        ASSERT_EQUAL(table->GetRow(1)[1].next_node_id, 2);
+        ASSERT_EQUAL(table->GetRow(1)[1].own_if_id, 2);
+        ASSERT_EQUAL(table->GetRow(1)[1].next_if_id, 1);
+        ASSERT_EQUAL(table->GetRow(1)[0].next_node_id, -2);
+        ASSERT_EQUAL(table->GetRow(3)[1].next_node_id, -2);
+
+        // The gateway is the address of the next hop interface
+        ASSERT_EQUAL(table->GetGatewayRow(0)[1], Ipv4Address("10.0.0.2").Get());
+        ASSERT_EQUAL(table->GetGatewayRow(1)[1], Ipv4Address("10.0.1.2").Get());
+        ASSERT_EQUAL(table->GetGatewayRow(2)[1], Ipv4Address("10.0.2.2").Get());
+        ArbiterResult result = arbiters[1]->Decide(0, 3, p, ipHeader, false);
+        ASSERT_FALSE(result.Failed());
+        ASSERT_EQUAL(result.GetOutIfIdx(), 2);
+        ASSERT_EQUAL(result.GetGatewayIpAddress(), Ipv4Address("10.0.1.2").Get());
+
+        // Drop
+        arbiters[2]->SetSingleForwardState(1, -1, -1, -1);
+        ASSERT_TRUE(arbiters[2]->TopologySatelliteNetworkDecide(2, 1, p, ipHeader, false) == std::make_tuple(-1, -1, -1));
+        ASSERT_EQUAL(table->GetGatewayRow(2)[0], 0);
+        ASSERT_TRUE(arbiters[2]->Decide(2, 1, p, ipHeader, false).Failed());
+
+        // A drop replaces an earlier next hop, including its gateway
+        arbiters[0]->SetSingleForwardState(3, -1, -1, -1);
+        ASSERT_TRUE(arbiters[0]->Decide(0, 3, p, ipHeader, false).Failed());
+        ASSERT_EQUAL(table->GetGatewayRow(0)[1], 0);
+
+        // Only destinations have a column to set
+        ASSERT_EXCEPTION(arbiters[0]->SetSingleForwardState(2, 1, 1, 1));
+        ASSERT_TRUE(arbiters[0]->TopologySatelliteNetworkDecide(0, 2, p, ipHeader, false) == invalid);
+
+        Simulator::Destroy();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
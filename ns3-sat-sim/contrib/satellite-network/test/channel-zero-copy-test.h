@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/gsl-channel.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/point-to-point-laser-net-device.h"
+#include "ns3/satnet-trace.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class ChannelZeroCopyTestCase : public TestCase {
+public:
+    ChannelZeroCopyTestCase () : TestCase ("channel zero-copy") {};
+
+    std::vector<Ptr<NetDevice>> devices;
+    uint64_t base_uid = 0;
+
+    // Packets handed to the devices, and how many of them arrived as the same object
+    std::vector<Ptr<Packet>> sent;
+    size_t num_received_sent = 0;
+
+    // Receptions and traces in order of occurrence, each with the time, relative packet
+    // UID, and the complete contents of the packet at that moment
+    std::vector<std::string> log;
+
+    std::string Describe(Ptr<const Packet> packet) {
+        std::vector<uint8_t> buffer(packet->GetSize());
+        packet->CopyData(buffer.data(), buffer.size());
+        return std::to_string(Simulator::Now().GetNanoSeconds()) + "," + std::to_string(packet->GetUid() - base_uid)
+               + "," + std::string(buffer.begin(), buffer.end());
+    }
+
+    bool Receive(uint32_t index, Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        log.push_back(std::to_string(index) + " Rx," + std::to_string(protocol) + "," + Describe(packet));
+        for (Ptr<Packet> p : sent) {
+            if (PeekPointer(p) == PeekPointer(packet)) {
+                num_received_sent++;
+            }
+        }
+        return true;
+    }
+
+    void Trace(std::string name, Ptr<const Packet> packet) {
+        log.push_back(name + "," + Describe(packet));
+    }
+
+    // Packets of different sizes with a different payload each
+    void SendPackets(uint32_t src, uint32_t first, uint32_t num) {
+        for (uint32_t i = first; i < first + num; i++) {
+            std::vector<uint8_t> payload(100 + 50 * i);
+            for (size_t k = 0; k < payload.size(); k++) {
+                payload[k] = (uint8_t) (31 * i + k);
+            }
+            Ptr<Packet> p = Create<Packet>(payload.data(), payload.size());
+            if (sent.empty()) {
+                base_uid = p->GetUid();
+            }
+            sent.push_back(p);
+            ASSERT_TRUE(devices[src]->Send(p, devices[1 - src]->GetAddress(), 0x0800));
+        }
+    }
+
+    /**
+     * Two nodes 300 km apart (a delay of about 1 ms) connected by either a GSL or an
+     * ISL at 10 Mbit/s: node 0 sends ten packets at t = 0, node 1 five at t = 0.5 ms.
+     *
+     * Returns the log of receptions and traces.
+     */
+    std::vector<std::string> RunScenario(bool isl, bool zero_copy, Time interframe_gap) {
+
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(0, 0, 0));
+        nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(300000, 0, 0));
+
+        if (isl) {
+            PointToPointLaserHelper p2p_laser_helper;
+            p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+            p2p_laser_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+            p2p_laser_helper.SetDeviceAttribute("InterframeGap", TimeValue(interframe_gap));
+            p2p_laser_helper.SetChannelAttribute("ZeroCopy", BooleanValue(zero_copy));
+            NetDeviceContainer container = p2p_laser_helper.Install(nodes);
+            devices.push_back(container.Get(0));
+            devices.push_back(container.Get(1));
+        } else {
+            GSLHelper gsl_helper;
+            gsl_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+            gsl_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+            gsl_helper.SetDeviceAttribute("InterframeGap", TimeValue(interframe_gap));
+            Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+            channel->SetAttribute("ZeroCopy", BooleanValue(zero_copy));
+            devices.push_back(gsl_helper.Install(nodes.Get(0), channel));
+            devices.push_back(gsl_helper.Install(nodes.Get(1), channel));
+        }
+
+        for (uint32_t i = 0; i < 2; i++) {
+            devices[i]->SetReceiveCallback(MakeCallback(&ChannelZeroCopyTestCase::Receive, this).Bind(i));
+#ifndef NS3_SATNET_TRACE_FREE
+            for (std::string name : {"MacTx", "MacRx", "PhyTxBegin", "PhyTxEnd", "PhyRxEnd", "Sniffer"}) {
+                devices[i]->TraceConnectWithoutContext(name, MakeCallback(&ChannelZeroCopyTestCase::Trace, this).Bind(std::to_string(i) + " " + name));
+            }
+#endif
+        }
+
+        Simulator::Schedule(MicroSeconds(0), &ChannelZeroCopyTestCase::SendPackets, this, 0, 0, 10);
+        Simulator::Schedule(MicroSeconds(500), &ChannelZeroCopyTestCase::SendPackets, this, 1, 10, 5);
+        Simulator::Stop(Seconds(1));
+        Simulator::Run();
+        Simulator::Destroy();
+
+        std::vector<std::string> result = log;
+        log.clear();
+        sent.clear();
+        devices.clear();
+        return result;
+    }
+
+    void DoRun () {
+
+        for (bool isl : {false, true}) {
+
+            // Without an interframe gap the delay exceeds it: zero-copy hands the packets over
+            // themselves, with exactly the same receptions and traces as with copying
+            std::vector<std::string> copied = RunScenario(isl, false, Seconds(0));
+            ASSERT_EQUAL(num_received_sent, 0);
+            std::vector<std::string> zero_copied = RunScenario(isl, true, Seconds(0));
+            ASSERT_EQUAL(num_received_sent, 15);
+            num_received_sent = 0;
+            ASSERT_EQUAL(zero_copied.size(), copied.size());
+            for (size_t i = 0; i < copied.size(); i++) {
+                ASSERT_EQUAL(zero_copied[i], copied[i]);
+            }
+
+            // An interframe gap of 2 ms exceeds the delay: the transmitting device still uses the
+            // packet (PhyTxEnd) after it arrived, so zero-copy falls back to copying
+            copied = RunScenario(isl, false, MilliSeconds(2));
+            zero_copied = RunScenario(isl, true, MilliSeconds(2));
+            ASSERT_EQUAL(num_received_sent, 0);
+            ASSERT_EQUAL(zero_copied.size(), copied.size());
+            for (size_t i = 0; i < copied.size(); i++) {
+                ASSERT_EQUAL(zero_copied[i], copied[i]);
+            }
+
+            // Per packet: MacTx, PhyTxBegin, PhyTxEnd and Sniffer at the transmitting device,
+            // and Sniffer, PhyRxEnd, MacRx and the reception at the receiving device
+#ifdef NS3_SATNET_TRACE_FREE
+            ASSERT_EQUAL(copied.size(), 15);
+#else
+            ASSERT_EQUAL(copied.size(), 8 * 15);
+#endif
+
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <cmath>
+#include <vector>
+#include <utility>
+
+#include "ns3/core-module.h"
+#include "ns3/julian-date.h"
+#include "ns3/frame-transform.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class FrameTransformTestCase : public TestCase {
+public:
+    FrameTransformTestCase () : TestCase ("frame-transform teme-to-itrf") {};
+
+    typedef std::vector<std::vector<double>> Matrix;
+
+    static Vector Multiply(const Matrix& m, const Vector& v) {
+        return Vector(
+            m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+            m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+            m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z
+        );
+    }
+
+    // PEF->ITRF (transposed) and TEME->PEF matrices, exactly as Satellite::PefToItrf and
+    // Satellite::TemeToPef computed them, except that the Earth can be rotated further
+    // by a residual (s) after t (0 for the removed implementation)
+    static Matrix OldPefToItrf(const JulianDate& t) {
+        std::pair<double, double> eop = t.GetPolarMotion();
+        const double &xp = eop.first, &yp = eop.second;
+        const double cosxp = cos(xp), cosyp = cos(yp);
+        const double sinxp = sin(xp), sinyp = sin(yp);
+        return {
+            {cosxp, sinyp * sinxp, cosyp * sinxp},
+            {0, cosyp, -sinyp},
+            {-sinxp, sinyp * cosxp, cosyp * cosxp}
+        };
+    }
+
+    static Matrix OldTemeToPef(const JulianDate& t, double residual) {
+        const double gmst = t.GetGmst() + t.GetOmegaEarth() * residual;
+        const double cosg = cos(gmst), sing = sin(gmst);
+        return {
+            {cosg, sing, 0},
+            {-sing, cosg, 0},
+            {0, 0, 1}
+        };
+    }
+
+    // Satellite::rTemeTorItrf
+    static Vector OldPosition(const Vector& rteme, const JulianDate& t, double residual) {
+        return Multiply(OldPefToItrf(t), Multiply(OldTemeToPef(t, residual), rteme));
+    }
+
+    // Satellite::rvTemeTovItrf
+    static Vector OldVelocity(const Vector& rteme, const Vector& vteme, const JulianDate& t, double residual) {
+        Matrix pmt = OldPefToItrf(t);
+        Matrix tmt = OldTemeToPef(t, residual);
+        Vector w(0.0, 0.0, t.GetOmegaEarth());
+        Vector r = Multiply(tmt, rteme);
+        Vector w_cross_r(w.y * r.z - w.z * r.y, w.z * r.x - w.x * r.z, w.x * r.y - w.y * r.x);
+        return Multiply(pmt, Multiply(tmt, vteme) - w_cross_r);
+    }
+
+    void AssertClose(Vector a, Vector b, double tolerance) {
+        ASSERT_EQUAL_APPROX(a.x, b.x, tolerance);
+        ASSERT_EQUAL_APPROX(a.y, b.y, tolerance);
+        ASSERT_EQUAL_APPROX(a.z, b.z, tolerance);
+    }
+
+    void AssertSame(Vector a, Vector b) {
+        ASSERT_EQUAL(a.x, b.x);
+        ASSERT_EQUAL(a.y, b.y);
+        ASSERT_EQUAL(a.z, b.z);
+    }
+
+    void DoRun () {
+
+        // TEME position (km) and velocity (km/s) of a LEO satellite at 550 km
+        const std::vector<std::pair<Vector, Vector>> states = {
+            std::make_pair(Vector(6928.137, 0.0, 0.0), Vector(0.0, 4.5649, 6.0580)),
+            std::make_pair(Vector(-3201.45, 4127.92, 4466.80), Vector(-5.8531, -4.4012, 0.0723)),
+            std::make_pair(Vector(1203.7, -6021.3, -3194.2), Vector(7.1021, 1.5237, 0.7981))
+        };
+
+        // Dates: the epoch of the generated shells (1 January 2000) and of the ISS TLE (2020)
+        const std::vector<JulianDate> starts = {
+            JulianDate(10957, 0),
+            JulianDate(18536, 44981131)
+        };
+
+        // Offsets (ns) from the start: whole milliseconds, and with a sub-millisecond residual
+        const std::vector<int64_t> offsets_ns = {
+            0, 1000000, 60000000000, 5400123000000,
+            1, 500000, 999999, 1234567, 5400123456789, -1500000
+        };
+
+        for (const JulianDate& start : starts) {
+            for (int64_t offset_ns : offsets_ns) {
+
+                // Millisecond-aligned date and residual (the remainder is never negative)
+                int64_t ms = offset_ns / 1000000;
+                int64_t residual_ns = offset_ns % 1000000;
+                if (residual_ns < 0) {
+                    ms--;
+                    residual_ns += 1000000;
+                }
+                JulianDate t = ms >= 0 ? start + MilliSeconds(ms) : start - MilliSeconds(-ms);
+                double residual = residual_ns * 1e-9;
+
+                FrameTransform transform(start, offset_ns);
+                ASSERT_TRUE(transform.GetDate() == t);
+                ASSERT_EQUAL(transform.GetOmegaEarth(), t.GetOmegaEarth());
+
+                for (const std::pair<Vector, Vector>& state : states) {
+
+                    // The same as the removed implementation (up to the order of the floating
+                    // point operations: within 1 um and 1 nm/s), with the residual applied as
+                    // an additional Earth rotation
+                    AssertClose(transform.TransformPosition(state.first), OldPosition(state.first, t, residual), 1e-9);
+                    AssertClose(transform.TransformVelocity(state.first, state.second), OldVelocity(state.first, state.second, t, residual), 1e-12);
+
+                    // On a whole millisecond, also the same as the transform at the date itself
+                    if (residual_ns == 0) {
+                        FrameTransform at_date(t);
+                        AssertSame(transform.TransformPosition(state.first), at_date.TransformPosition(state.first));
+                        AssertSame(transform.TransformVelocity(state.first, state.second), at_date.TransformVelocity(state.first, state.second));
+                        AssertClose(at_date.TransformPosition(state.first), OldPosition(state.first, t, 0.0), 1e-9);
+                    }
+
+                    // The shared instance is the same as a separately constructed one
+                    AssertSame(FrameTransform::TemeToItrf(start, offset_ns).TransformPosition(state.first), transform.TransformPosition(state.first));
+                    AssertSame(FrameTransform::TemeToItrf(start, offset_ns).TransformVelocity(state.first, state.second), transform.TransformVelocity(state.first, state.second));
+
+                }
+
+            }
+
+            // Just before the next millisecond it is within 5 cm (the GMST resolution of a Julian date
+            // as a double) of the removed implementation at that millisecond, such that there is no
+            // jump where the residual wraps around, whereas 1 ms earlier the Earth rotated 40 to 50 cm
+            for (const std::pair<Vector, Vector>& state : states) {
+                Vector old_position = OldPosition(state.first, start + MilliSeconds(60), 0.0);
+                ASSERT_TRUE(CalculateDistance(FrameTransform(start, 59999999).TransformPosition(state.first), old_position) < 5e-5);
+                ASSERT_TRUE(CalculateDistance(FrameTransform(start, 59000001).TransformPosition(state.first), old_position) > 2.5e-4);
+            }
+
+        }
+
+        // The shared instance is recomputed when the time instant changes, also back and forth
+        Vector r = states[0].first;
+        Vector a = FrameTransform(starts[0], 1500000).TransformPosition(r);
+        Vector b = FrameTransform(starts[0], 1500001).TransformPosition(r);
+        Vector c = FrameTransform(starts[1], 1500000).TransformPosition(r);
+        AssertSame(FrameTransform::TemeToItrf(starts[0], 1500000).TransformPosition(r), a);
+        AssertSame(FrameTransform::TemeToItrf(starts[0], 1500001).TransformPosition(r), b);
+        AssertSame(FrameTransform::TemeToItrf(starts[0], 1500000).TransformPosition(r), a);
+        AssertSame(FrameTransform::TemeToItrf(starts[1], 1500000).TransformPosition(r), c);
+        AssertSame(FrameTransform::TemeToItrf(starts[0] + MilliSeconds(1), 0).TransformPosition(r), FrameTransform(starts[0], 1000000).TransformPosition(r));
+        AssertSame(FrameTransform::TemeToItrf(starts[1]).TransformPosition(r), FrameTransform(starts[1]).TransformPosition(r));
+        AssertSame(FrameTransform::TemeToItrf(starts[0]).TransformPosition(r), FrameTransform(starts[0]).TransformPosition(r));
+        ASSERT_TRUE(CalculateDistance(a, b) > 0.0);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ppp-header.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/gsl-channel.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Exposes the exact (uncached) delay computation
+class TestGSLChannel : public GSLChannel {
+public:
+    using GSLChannel::GetDelay;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslChannelDelayCacheTestCase : public TestCase {
+public:
+    GslChannelDelayCacheTestCase () : TestCase ("gsl-channel delay-cache") {};
+
+    Ptr<TestGSLChannel> channel;
+    NodeContainer nodes;
+
+    // Per transmission (in order), and per receiving device (in order of arrival)
+    std::vector<Time> sent_at;
+    std::vector<Time> exact_delays;
+    std::vector<Time> received_at[2];
+    std::vector<uint32_t> sent_to;
+
+    // Counters after the period with the cache enabled
+    uint64_t hits_before_disabled = 0;
+    uint64_t misses_before_disabled = 0;
+
+    bool Receive(uint32_t index, Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        received_at[index].push_back(Simulator::Now());
+        return true;
+    }
+
+    // Transmits a packet directly over the channel (without transmission time),
+    // and records the exact delay at this moment for comparison
+    void Transmit(uint32_t src, uint32_t dst) {
+        sent_at.push_back(Simulator::Now());
+        sent_to.push_back(dst);
+        exact_delays.push_back(channel->GetDelay(nodes.Get(src)->GetObject<MobilityModel>(), nodes.Get(dst)->GetObject<MobilityModel>()));
+        Ptr<Packet> p = Create<Packet>(100);
+        PppHeader ppp;
+        ppp.SetProtocol(0x0021);
+        p->AddHeader(ppp);
+        channel->TransmitTo(p, src, dst, Seconds(0));
+    }
+
+    void DoRun () {
+
+        // Node 0 stays at the origin, node 1 moves away from it at 10 km/s (0.033 ns more delay per us)
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+        mobility.Install(nodes);
+        nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(0, 0, 0));
+        nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(1000000, 0, 0));
+        nodes.Get(1)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(10000, 0, 0));
+
+        // One GSL device per node, which are device 0 and 1 of the channel
+        GSLHelper gsl_helper;
+        channel = CreateObject<TestGSLChannel>();
+        channel->SetAttribute("DelayCacheQuantum", TimeValue(MicroSeconds(1000)));
+        for (uint32_t i = 0; i < 2; i++) {
+            Ptr<GSLNetDevice> device = gsl_helper.Install(nodes.Get(i), channel);
+            device->SetReceiveCallback(MakeCallback(&GslChannelDelayCacheTestCase::Receive, this).Bind(i));
+        }
+
+        // Quantum of 1 ms: each direction has its own entry
+        Simulator::Schedule(MicroSeconds(0), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1);    // 0: Miss
+        Simulator::Schedule(MicroSeconds(200), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1);  // 1: Hit (0)
+        Simulator::Schedule(MicroSeconds(500), &GslChannelDelayCacheTestCase::Transmit, this, 1, 0);  // 2: Miss
+        Simulator::Schedule(MicroSeconds(600), &GslChannelDelayCacheTestCase::Transmit, this, 1, 0);  // 3: Hit (2)
+        Simulator::Schedule(MicroSeconds(900), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1);  // 4: Hit (0)
+        Simulator::Schedule(MicroSeconds(1000), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 5: Miss
+        Simulator::Schedule(MicroSeconds(1500), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 6: Hit (5)
+        Simulator::Schedule(MicroSeconds(2500), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 7: Miss
+
+        // Quantum of 1.25 ms: t = 2.6 ms is in quantum 2 just as t = 2.5 ms was before,
+        // but the entry was computed with the other quantum so it is recomputed
+        Simulator::Schedule(MicroSeconds(2550), [this](){
+            channel->SetAttribute("DelayCacheQuantum", TimeValue(MicroSeconds(1250)));
+        });
+        Simulator::Schedule(MicroSeconds(2600), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 8: Miss
+        Simulator::Schedule(MicroSeconds(3000), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 9: Hit (8)
+
+        // Quantum of 0: every packet has its exact delay, and the cache is not used
+        Simulator::Schedule(MicroSeconds(3500), [this](){
+            hits_before_disabled = channel->GetDelayCacheHits();
+            misses_before_disabled = channel->GetDelayCacheMisses();
+            channel->SetAttribute("DelayCacheQuantum", TimeValue(Seconds(0)));
+        });
+        Simulator::Schedule(MicroSeconds(4000), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 10: Exact
+        Simulator::Schedule(MicroSeconds(4100), &GslChannelDelayCacheTestCase::Transmit, this, 0, 1); // 11: Exact
+
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // Hit and miss counts
+        ASSERT_EQUAL(hits_before_disabled, 5);
+        ASSERT_EQUAL(misses_before_disabled, 5);
+        ASSERT_EQUAL(channel->GetDelayCacheHits(), 5);
+        ASSERT_EQUAL(channel->GetDelayCacheMisses(), 5);
+
+        // Every packet arrived
+        ASSERT_EQUAL(sent_at.size(), 12);
+        ASSERT_EQUAL(received_at[0].size(), 2);
+        ASSERT_EQUAL(received_at[1].size(), 10);
+
+        // Delay of each packet: the exact delay of the transmission which computed it
+        std::vector<size_t> computed_by = {0, 0, 2, 2, 0, 5, 5, 7, 8, 8, 10, 11};
+        size_t next_received[2] = {0, 0};
+        for (size_t i = 0; i < sent_at.size(); i++) {
+            uint32_t dst = sent_to[i];
+            Time delay = received_at[dst][next_received[dst]++] - sent_at[i];
+            ASSERT_EQUAL(delay, exact_delays[computed_by[i]]);
+        }
+
+        // The node moved enough that reusing a delay is distinguishable from the exact delay
+        ASSERT_NOT_EQUAL(exact_delays[4], exact_delays[0]);
+        ASSERT_NOT_EQUAL(exact_delays[6], exact_delays[5]);
+        ASSERT_NOT_EQUAL(exact_delays[8], exact_delays[7]);
+        ASSERT_NOT_EQUAL(exact_delays[9], exact_delays[8]);
+        ASSERT_NOT_EQUAL(exact_delays[11], exact_delays[10]);
+
+        // The delay is the distance over the speed of light
+        ASSERT_EQUAL_APPROX(exact_delays[0].GetSeconds(), 1000000.0 / 299792458.0, 0.000000001);
+
+        channel = 0;
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslLookaheadTestCase : public TestCase {
+public:
+    GslLookaheadTestCase () : TestCase ("gsl-lookahead min-delay") {};
+
+    const std::string temp_dir = ".tmp-gsl-lookahead-test";
+
+    // Lowest GSL delay over all satellite and ground station pairs, at every sample
+    double min_delay_s = std::numeric_limits<double>::max();
+
+    // Three satellites of a 550 km shell (as the end-to-end-special test)
+    const std::vector<std::pair<std::string, std::string>> tles = {
+        std::make_pair(
+            "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03",
+            "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08"
+        ),
+        std::make_pair(
+            "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09",
+            "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01"
+        ),
+        std::make_pair(
+            "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07",
+            "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00"
+        )
+    };
+
+    // Run directory with the ground stations at the given cartesian positions
+    void PrepareRunDir(const std::vector<Vector>& ground_station_positions) {
+        mkdir_if_not_exists(temp_dir);
+
+        std::ofstream config_file(temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=200000000000" << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=." << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file.close();
+
+        std::ofstream tles_file(temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        for (size_t i = 0; i < tles.size(); i++) {
+            tles_file << "Starlink-550 " << i << std::endl;
+            tles_file << tles[i].first << std::endl;
+            tles_file << tles[i].second << std::endl;
+        }
+        tles_file.close();
+
+        std::ofstream isls_file(temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        std::ofstream ground_stations_file(temp_dir + "/ground_stations.txt");
+        for (size_t i = 0; i < ground_station_positions.size(); i++) {
+            const Vector& p = ground_station_positions[i];
+            ground_stations_file << i << ",Ground-station-" << i << ",0.0,0.0,0.0,"
+                                 << format_string("%.6f,%.6f,%.6f", p.x, p.y, p.z) << std::endl;
+        }
+        ground_stations_file.close();
+
+        std::ofstream gsl_interfaces_info_file(temp_dir + "/gsl_interfaces_info.txt");
+        for (size_t i = 0; i < tles.size() + ground_station_positions.size(); i++) {
+            gsl_interfaces_info_file << i << ",1,1.0" << std::endl;
+        }
+        gsl_interfaces_info_file.close();
+    }
+
+    // Samples the delay of every satellite and ground station pair (as the GSL channel computes it)
+    void SampleMinDelay(Ptr<TopologySatelliteNetwork> topology) {
+        for (uint32_t s = 0; s < topology->GetNumSatellites(); s++) {
+            Ptr<MobilityModel> satellite_mobility = topology->GetSatelliteNodes().Get(s)->GetObject<MobilityModel>();
+            for (uint32_t g = 0; g < topology->GetNumGroundStations(); g++) {
+                Ptr<MobilityModel> ground_station_mobility = topology->GetGroundStationNodes().Get(g)->GetObject<MobilityModel>();
+                min_delay_s = std::min(min_delay_s, satellite_mobility->GetDistanceFrom(ground_station_mobility) / 299792458.0);
+            }
+        }
+    }
+
+    void DoRun () {
+
+        // Ground stations at sea level: New York, and directly below satellite 0 at t = 60s,
+        // such that the lowest GSL delay of the run is (about) that of the altitude
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetTleInfo(tles[0].first, tles[0].second);
+        Vector below = SatellitePositionHelper(satellite).GetPosition(Seconds(60));
+        double below_scale = 6371000.0 / below.GetLength();
+        std::vector<Vector> ground_station_positions = {
+            Vector(1334103.172127, -4653693.528901, 4138656.197504),
+            Vector(below.x * below_scale, below.y * below_scale, below.z * below_scale)
+        };
+        PrepareRunDir(ground_station_positions);
+
+        // Lookahead
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        Time lookahead = topology->GetGslLookahead();
+        ASSERT_TRUE(lookahead.IsStrictlyPositive());
+
+        // Lowest delay over the run, sampled every 100 ms
+        for (int64_t t_ms = 0; t_ms < 200000; t_ms += 100) {
+            Simulator::Schedule(MilliSeconds(t_ms), &GslLookaheadTestCase::SampleMinDelay, this, topology);
+        }
+        Simulator::Run();
+
+        // The lookahead is a lower bound, but not overly conservative (its margin is 10%)
+        ASSERT_TRUE(min_delay_s < 0.002);
+        ASSERT_TRUE(lookahead.GetSeconds() <= min_delay_s);
+        ASSERT_TRUE(lookahead.GetSeconds() >= 0.85 * min_delay_s);
+
+#ifdef NS3_MPI
+        // Without the distributed simulator there is no lookahead to bound, and no channel bundles
+        topology->BoundDistributedLookahead(lookahead);
+        ASSERT_EQUAL(RemoteChannelBundleManager::Size(), 0);
+#endif
+
+        basicSimulation->Finalize();
+
+        // A ground station higher than the satellites (at 1000 km altitude) has no lower bound
+        ground_station_positions.push_back(Vector(7371000.0, 0.0, 0.0));
+        PrepareRunDir(ground_station_positions);
+        basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ASSERT_EXCEPTION(topology->GetGslLookahead());
+        basicSimulation->Finalize();
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
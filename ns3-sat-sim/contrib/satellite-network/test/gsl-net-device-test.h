@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/gsl-helper.h"
+#include "ns3/gsl-net-device.h"
+#include "ns3/gsl-channel.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslNetDeviceQueueDestinationsTestCase : public TestCase {
+public:
+    GslNetDeviceQueueDestinationsTestCase () : TestCase ("gsl-net-device queue-destinations") {};
+
+    std::vector<Ptr<GSLNetDevice>> devices;
+    std::vector<uint32_t> expected_sizes[3];
+    std::vector<uint32_t> received_sizes[3];
+
+    bool Receive(uint32_t index, Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        received_sizes[index].push_back(packet->GetSize());
+        return true;
+    }
+
+    void SendBurst(uint32_t first, uint32_t num) {
+        for (uint32_t i = first; i < first + num; i++) {
+            uint32_t destination = i % 3 == 0 ? 2 : 1; // Pattern: 2, 1, 1, 2, 1, 1, ...
+            ASSERT_TRUE(devices[0]->Send(Create<Packet>(100 + i), devices[destination]->GetAddress(), 0x0800));
+            expected_sizes[destination].push_back(100 + i);
+        }
+    }
+
+    void DoRun () {
+
+        // Three nodes at fixed positions
+        NodeContainer nodes;
+        nodes.Create(3);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(0, 0, 0));
+        nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(1000000, 0, 0));
+        nodes.Get(2)->GetObject<MobilityModel>()->SetPosition(Vector(0, 1000000, 0));
+
+        // One GSL device per node, with a queue limited in bytes (such that the
+        // destinations of the queued packets start at 64 entries and have to grow)
+        GSLHelper gsl_helper;
+        gsl_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("1000000B")));
+        gsl_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        Ptr<GSLChannel> channel = CreateObject<GSLChannel>();
+        for (uint32_t i = 0; i < 3; i++) {
+            devices.push_back(gsl_helper.Install(nodes.Get(i), channel));
+            devices[i]->SetReceiveCallback(MakeCallback(&GslNetDeviceQueueDestinationsTestCase::Receive, this).Bind(i));
+        }
+
+        // First burst of 200 packets fills the queue beyond its initial 64 destinations (growth)
+        SendBurst(0, 200);
+        ASSERT_EQUAL(devices[0]->GetQueue()->GetNPackets(), 199); // The first is being transmitted
+
+        // Two more bursts once part of the first has been sent (about 85 packets), such that
+        // the destinations wrap around the end of the ring, and it grows again while wrapped
+        Simulator::Schedule(MilliSeconds(125), &GslNetDeviceQueueDestinationsTestCase::SendBurst, this, 200, 150);
+        Simulator::Schedule(MilliSeconds(125), &GslNetDeviceQueueDestinationsTestCase::SendBurst, this, 350, 150);
+        Simulator::Stop(Seconds(10));
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // Every packet arrived at its own destination, in order
+        ASSERT_EQUAL(devices[0]->GetQueue()->GetNPackets(), 0);
+        ASSERT_EQUAL(received_sizes[0].size(), 0);
+        ASSERT_EQUAL(received_sizes[1].size(), 333);
+        ASSERT_EQUAL(received_sizes[2].size(), 167);
+        for (uint32_t d = 1; d < 3; d++) {
+            ASSERT_EQUAL(received_sizes[d].size(), expected_sizes[d].size());
+            for (size_t i = 0; i < received_sizes[d].size(); i++) {
+                ASSERT_EQUAL(received_sizes[d][i], expected_sizes[d][i]);
+            }
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
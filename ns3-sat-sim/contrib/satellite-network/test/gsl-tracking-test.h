@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <map>
+#include <set>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "ns3/basic-simulation.h"
+#include "ns3/udp-burst-scheduler.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/tcp-optimizer.h"
+#include "ns3/arbiter-single-forward-helper.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/gsl-if-bandwidth-helper.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class GslTrackingTestCase : public TestCase {
+public:
+    GslTrackingTestCase () : TestCase ("gsl-tracking") {};
+
+    const int64_t simulation_end_time_ns = 10000000000; // 10s
+    const int64_t interval_ns = 100000000; // 100ms
+
+    // Topology (same as the end-to-end-special test)
+    //
+    // Satellites:               0 ----- 1        2
+    //                          ||       ||       |
+    //                   ( ......... GSL channel ......... )
+    //                    ||    |               |    |
+    // Ground stations:   3     4               5    6
+    //
+    // Tracking is only enabled for satellite 1 and ground station 0 (node 3),
+    // which both have two GSL interfaces which all send traffic.
+    void PrepareRunDir(const std::string& temp_dir, bool streaming) {
+        const std::string dyn_state_dir = temp_dir + "/dynamic_state";
+        mkdir_if_not_exists(temp_dir);
+        mkdir_if_not_exists(dyn_state_dir);
+
+        // A configuration file
+        std::ofstream config_file;
+        config_file.open (temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=" << simulation_end_time_ns << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=dynamic_state" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "enable_gsl_utilization_tracking=true" << std::endl;
+        config_file << "gsl_utilization_tracking_interval_ns=" << interval_ns << std::endl;
+        config_file << "gsl_utilization_tracking_streaming=" << (streaming ? "true" : "false") << std::endl;
+        config_file << "enable_gsl_queue_tracking=true" << std::endl;
+        config_file << "gsl_tracking_enable_for_satellites=set(1)" << std::endl;
+        config_file << "gsl_tracking_enable_for_ground_stations=set(0)" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=" << interval_ns << std::endl;
+        config_file << "enable_udp_burst_scheduler=true" << std::endl;
+        config_file << "udp_burst_schedule_filename=udp_burst_schedule.csv" << std::endl;
+        config_file.close();
+
+        // UDP burst schedule
+        std::ofstream udp_burst_schedule_file;
+        udp_burst_schedule_file.open (temp_dir + "/udp_burst_schedule.csv");
+        udp_burst_schedule_file << "0,3,5,10,0,1000000000000,," << std::endl;
+        udp_burst_schedule_file << "1,3,6,10,0,1000000000000,," << std::endl;
+        udp_burst_schedule_file << "2,4,5,6,0,1000000000000,," << std::endl;
+        udp_burst_schedule_file << "3,4,6,4,0,1000000000000,," << std::endl;
+        udp_burst_schedule_file.close();
+
+        // TLES
+        std::ofstream tles_file;
+        tles_file.open (temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        tles_file << "Starlink-550 0" << std::endl; // 1477
+        tles_file << "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03" << std::endl;
+        tles_file << "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08" << std::endl;
+        tles_file << "Starlink-550 1" << std::endl; // 1499
+        tles_file << "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09" << std::endl;
+        tles_file << "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01" << std::endl;
+        tles_file << "Starlink-550 2" << std::endl; // 1543
+        tles_file << "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07" << std::endl;
+        tles_file << "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00" << std::endl;
+        tles_file.close();
+
+        // ISLs
+        std::ofstream isls_file;
+        isls_file.open (temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        // Ground stations
+        std::ofstream ground_stations_file;
+        ground_stations_file.open (temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        // GSL interfaces info
+        std::ofstream gsl_interfaces_info_file;
+        gsl_interfaces_info_file.open (temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+
+        // Dynamic state
+        for (int64_t i = 0; i < simulation_end_time_ns; i += interval_ns) {
+            std::ofstream fstate_file;
+            fstate_file.open (dyn_state_dir + "/fstate_" + std::to_string(i) + ".txt");
+            if (i == 0) {
+                fstate_file << "3,5,0,0,1" << std::endl;
+                fstate_file << "0,5,1,0,0" << std::endl;
+                fstate_file << "1,5,5,1,0" << std::endl;
+                fstate_file << "3,6,1,1,1" << std::endl;
+                fstate_file << "1,6,6,2,0" << std::endl;
+                fstate_file << "4,5,1,0,1" << std::endl;
+                fstate_file << "4,6,2,0,0" << std::endl;
+                fstate_file << "2,6,6,0,0" << std::endl;
+            }
+            fstate_file.close();
+
+            std::ofstream gsl_if_bandwidth_file;
+            gsl_if_bandwidth_file.open (dyn_state_dir + "/gsl_if_bandwidth_" + std::to_string(i) + ".txt");
+            gsl_if_bandwidth_file.close();
+        }
+
+    }
+
+    void RunSimulation(const std::string& temp_dir) {
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        TcpOptimizer::OptimizeBasic(basicSimulation);
+        Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
+        GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
+        UdpBurstScheduler udpBurstScheduler(basicSimulation, topology);
+        basicSimulation->Run();
+        udpBurstScheduler.WriteResults();
+        topology->CollectUtilizationStatistics();
+        basicSimulation->Finalize();
+    }
+
+    /**
+     * Checks that the lines of a GSL tracking file are only of the tracked interfaces,
+     * and that for each of them the intervals are consecutive and cover the entire run.
+     *
+     * Equal consecutive intervals must have been merged. The values are put into
+     * the map by "<node id>,<gsl if id>".
+     */
+    void CheckTrackingFile(const std::vector<std::string>& lines, std::map<std::string, std::vector<double>>& values) {
+        std::map<std::string, int64_t> prev_end_ns;
+        for (const std::string& line : lines) {
+            std::vector<std::string> line_spl = split_string(line, ",", 5);
+            std::string key = line_spl[0] + "," + line_spl[1];
+            int64_t start_ns = parse_positive_int64(line_spl[2]);
+            int64_t end_ns = parse_positive_int64(line_spl[3]);
+            double value = parse_positive_double(line_spl[4]);
+            ASSERT_EQUAL(start_ns, prev_end_ns.count(key) ? prev_end_ns[key] : 0);
+            ASSERT_TRUE(end_ns > start_ns);
+            if (values.count(key)) {
+                ASSERT_NOT_EQUAL(value, values[key].back());
+            }
+            prev_end_ns[key] = end_ns;
+            values[key].push_back(value);
+        }
+        std::set<std::string> keys;
+        for (const auto& p : prev_end_ns) {
+            keys.insert(p.first);
+            ASSERT_EQUAL(p.second, simulation_end_time_ns);
+        }
+        std::set<std::string> expected_keys = {"1,0", "1,1", "3,0", "3,1"};
+        ASSERT_TRUE(keys == expected_keys);
+    }
+
+    void DoRun () {
+
+        // Without streaming
+        const std::string temp_dir = ".tmp-gsl-tracking-test";
+        PrepareRunDir(temp_dir, false);
+        RunSimulation(temp_dir);
+        std::vector<std::string> lines_utilization = read_file_direct(temp_dir + "/logs_ns3/gsl_utilization.csv");
+        std::vector<std::string> lines_queue = read_file_direct(temp_dir + "/logs_ns3/gsl_queue.csv");
+
+        // Utilization: every tracked interface sends traffic
+        std::map<std::string, std::vector<double>> utilization;
+        CheckTrackingFile(lines_utilization, utilization);
+        for (const auto& p : utilization) {
+            double max_utilization = 0.0;
+            for (double u : p.second) {
+                ASSERT_TRUE(u <= 1.0);
+                max_utilization = std::max(max_utilization, u);
+            }
+            ASSERT_TRUE(max_utilization > 0.0);
+        }
+
+        // Queue: number of packets never exceeds the device queue size
+        std::map<std::string, std::vector<double>> queue;
+        CheckTrackingFile(lines_queue, queue);
+        for (const auto& p : queue) {
+            for (double num_packets : p.second) {
+                ASSERT_TRUE(num_packets <= 75);
+            }
+        }
+
+        // With streaming, the utilization runs are the same, only interleaved differently
+        const std::string temp_dir_streaming = ".tmp-gsl-tracking-streaming-test";
+        PrepareRunDir(temp_dir_streaming, true);
+        RunSimulation(temp_dir_streaming);
+        std::vector<std::string> lines_utilization_streaming = read_file_direct(temp_dir_streaming + "/logs_ns3/gsl_utilization.csv");
+        std::sort(lines_utilization.begin(), lines_utilization.end());
+        std::sort(lines_utilization_streaming.begin(), lines_utilization_streaming.end());
+        ASSERT_TRUE(lines_utilization == lines_utilization_streaming);
+        std::vector<std::string> lines_queue_streaming = read_file_direct(temp_dir_streaming + "/logs_ns3/gsl_queue.csv");
+        ASSERT_TRUE(lines_queue == lines_queue_streaming);
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
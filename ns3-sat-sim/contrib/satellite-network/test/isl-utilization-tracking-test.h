@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/exp-util.h"
+#include "ns3/point-to-point-laser-helper.h"
+#include "ns3/point-to-point-laser-net-device.h"
+#include "ns3/utilization-run-writer.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class IslUtilizationTrackingTestCase : public TestCase {
+public:
+    IslUtilizationTrackingTestCase () : TestCase ("isl-utilization-tracking") {};
+
+    Ptr<PointToPointLaserNetDevice> dev_a;
+    Ptr<PointToPointLaserNetDevice> dev_b;
+
+    bool Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address& from) {
+        return true;
+    }
+
+    void SendPackets(uint32_t num) {
+        for (uint32_t i = 0; i < num; i++) {
+            // 123 byte payload + 2 byte PPP header = 1000 bits = 1 ms at 1 Mbit/s
+            ASSERT_TRUE(dev_a->Send(Create<Packet>(123), dev_b->GetAddress(), 0x0800));
+        }
+    }
+
+    /**
+     * Sends over an ISL at 1 Mbit/s which is tracked in 1 ms intervals:
+     * three packets at t=0 (busy 0-3 ms) and one at t=5.5 ms (busy 5.5-6.5 ms),
+     * after which it is idle until the end at 10 ms. The intervals are thus:
+     *
+     *   [0, 1), [1, 2), [2, 3): 1.0
+     *   [3, 4), [4, 5): 0.0
+     *   [5, 6), [6, 7): 0.5
+     *   [7, 8), [8, 9), [9, 10): 0.0 (the run which is still open at the end)
+     *
+     * Returns the runs which FinalizeUtilization() keeps in memory.
+     */
+    std::vector<UtilizationRun> RunScenario(Ptr<UtilizationRunWriter> writer) {
+
+        // Two satellites at a fixed distance
+        NodeContainer nodes;
+        nodes.Create(2);
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        mobility.Install(nodes);
+        nodes.Get(0)->GetObject<MobilityModel>()->SetPosition(Vector(0, 0, 0));
+        nodes.Get(1)->GetObject<MobilityModel>()->SetPosition(Vector(1000000, 0, 0));
+
+        // ISL between them
+        PointToPointLaserHelper p2p_laser_helper;
+        p2p_laser_helper.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", QueueSizeValue(QueueSize("100p")));
+        p2p_laser_helper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+        NetDeviceContainer devices = p2p_laser_helper.Install(nodes);
+        dev_a = devices.Get(0)->GetObject<PointToPointLaserNetDevice>();
+        dev_b = devices.Get(1)->GetObject<PointToPointLaserNetDevice>();
+        dev_b->SetReceiveCallback(MakeCallback(&IslUtilizationTrackingTestCase::Receive, this));
+
+        // Track utilization of the sending side, streamed to the writer if there is one
+        if (writer) {
+            dev_a->EnableUtilizationTracking(1000000, writer, 0, 1);
+        } else {
+            dev_a->EnableUtilizationTracking(1000000);
+        }
+
+        // Traffic
+        Simulator::Schedule(NanoSeconds(0), &IslUtilizationTrackingTestCase::SendPackets, this, 3);
+        Simulator::Schedule(NanoSeconds(5500000), &IslUtilizationTrackingTestCase::SendPackets, this, 1);
+        Simulator::Stop(NanoSeconds(10000000));
+        Simulator::Run();
+        std::vector<UtilizationRun> runs = dev_a->FinalizeUtilization();
+        Simulator::Destroy();
+        dev_a = 0;
+        dev_b = 0;
+        return runs;
+    }
+
+    void DoRun () {
+
+        // Without streaming, all the runs are kept in memory, equal intervals merged
+        std::vector<UtilizationRun> runs = RunScenario(0);
+        ASSERT_EQUAL(runs.size(), 4);
+        ASSERT_EQUAL(runs[0].start_ns, 0);
+        ASSERT_EQUAL(runs[0].end_ns, 3000000);
+        ASSERT_EQUAL(runs[0].utilization, 1.0);
+        ASSERT_EQUAL(runs[1].start_ns, 3000000);
+        ASSERT_EQUAL(runs[1].end_ns, 5000000);
+        ASSERT_EQUAL(runs[1].utilization, 0.0);
+        ASSERT_EQUAL(runs[2].start_ns, 5000000);
+        ASSERT_EQUAL(runs[2].end_ns, 7000000);
+        ASSERT_EQUAL(runs[2].utilization, 0.5);
+        ASSERT_EQUAL(runs[3].start_ns, 7000000);
+        ASSERT_EQUAL(runs[3].end_ns, 10000000);
+        ASSERT_EQUAL(runs[3].utilization, 0.0);
+
+        // With streaming, the same runs end up in the file (including the final
+        // open run, which is written by finalization) and none are kept in memory
+        const std::string filename = ".tmp-isl-utilization-tracking-test.csv";
+        Ptr<UtilizationRunWriter> writer = Create<UtilizationRunWriter>(filename, 1024);
+        runs = RunScenario(writer);
+        writer->Close();
+        ASSERT_EQUAL(runs.size(), 0);
+        std::vector<std::string> lines = read_file_direct(filename);
+        ASSERT_EQUAL(lines.size(), 4);
+        ASSERT_EQUAL(lines[0], "0,1,0,3000000,1.000000");
+        ASSERT_EQUAL(lines[1], "0,1,3000000,5000000,0.000000");
+        ASSERT_EQUAL(lines[2], "0,1,5000000,7000000,0.500000");
+        ASSERT_EQUAL(lines[3], "0,1,7000000,10000000,0.000000");
+
+        // Clean-up
+        remove_file_if_exists(filename);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
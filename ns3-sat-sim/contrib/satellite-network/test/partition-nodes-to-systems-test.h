@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+
+#include "ns3/vector.h"
+#include "ns3/topology-satellite-network.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PartitionNodesToSystemsTestCase : public TestCase {
+public:
+    PartitionNodesToSystemsTestCase () : TestCase ("partition-nodes-to-systems") {};
+
+    void AssertAssignment(const std::vector<int64_t>& assignment, const std::vector<int64_t>& expected) {
+        ASSERT_EQUAL(assignment.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQUAL(assignment[i], expected[i]);
+        }
+    }
+
+    void DoRun () {
+
+        // 4 orbits of 3 satellites, satellite i at (i * 1000, 0, 0)
+        std::vector<Vector> satellite_positions;
+        for (int64_t i = 0; i < 12; i++) {
+            satellite_positions.push_back(Vector(i * 1000, 0, 0));
+        }
+
+        // Single system: everything on it
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(1, 4, 3, satellite_positions, {Vector(0, 10, 0)}),
+                {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+        );
+
+        // Two systems: two whole orbits each
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(2, 4, 3, satellite_positions, {}),
+                {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1}
+        );
+
+        // Three systems: orbits are not split, so one system gets two orbits
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(3, 4, 3, satellite_positions, {}),
+                {0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 2}
+        );
+
+        // More systems than orbits: single satellites instead
+        std::vector<Vector> six_satellite_positions(satellite_positions.begin(), satellite_positions.begin() + 6);
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(4, 2, 3, six_satellite_positions, {}),
+                {0, 0, 1, 2, 2, 3}
+        );
+
+        // Ground stations go to the system of their closest satellite, up to an even share
+        // (2 each): the third one close to system 0 goes to system 1 instead
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(
+                        2, 4, 3, satellite_positions,
+                        {Vector(0, 10, 0), Vector(1000, 10, 0), Vector(2000, 10, 0), Vector(11000, 10, 0)}
+                ),
+                {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1, 1}
+        );
+
+        // Ground stations close to the last system only spill over to the one with the fewest
+        AssertAssignment(
+                TopologySatelliteNetwork::PartitionNodesToSystems(
+                        3, 4, 3, satellite_positions,
+                        {Vector(11000, 10, 0), Vector(10000, 10, 0), Vector(9000, 10, 0)}
+                ),
+                {0, 0, 0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 2, 0, 1}
+        );
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/point-to-point-laser-channel.h"
+#include "ns3/point-to-point-laser-remote-channel.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+// Channels of which the delay calculations can be called directly
+class TestPointToPointLaserChannel : public PointToPointLaserChannel {
+public:
+    using PointToPointLaserChannel::GetDelay;
+    using PointToPointLaserChannel::GetExactDelay;
+    using PointToPointLaserChannel::GetDelayAt;
+    using PointToPointLaserChannel::GetLowerBoundDelay;
+};
+
+class TestPointToPointLaserRemoteChannel : public PointToPointLaserRemoteChannel {
+public:
+    using PointToPointLaserRemoteChannel::GetDelay;
+    using PointToPointLaserChannel::GetExactDelay;
+    using PointToPointLaserChannel::GetLowerBoundDelay;
+};
+
+class PointToPointLaserChannelTestCase : public TestCase {
+public:
+    PointToPointLaserChannelTestCase (std::string s) : TestCase (s) {};
+
+    // Satellite 0 and 1 of the end-to-end-special test, which have an ISL
+    Ptr<SatellitePositionMobilityModel> CreateSatelliteMobility(uint32_t i) {
+        if (i == 0) {
+            return CreateSatelliteMobility(
+                    "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03",
+                    "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08",
+                    Seconds(0)
+            );
+        } else {
+            return CreateSatelliteMobility(
+                    "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09",
+                    "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01",
+                    Seconds(0)
+            );
+        }
+    }
+
+    // Mobility of a satellite of which the simulation starts the given time before the TLE epoch
+    Ptr<SatellitePositionMobilityModel> CreateSatelliteMobility(std::string tle1, std::string tle2, Time before_epoch) {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetTleInfo(tle1, tle2);
+        Ptr<SatellitePositionMobilityModel> mobility = CreateObject<SatellitePositionMobilityModel>();
+        mobility->SetSatellite(satellite);
+        mobility->SetStartTime(satellite->GetTleEpoch() - before_epoch);
+        return mobility;
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PointToPointLaserChannelMinDelayTestCase : public PointToPointLaserChannelTestCase {
+public:
+    PointToPointLaserChannelMinDelayTestCase () : PointToPointLaserChannelTestCase ("point-to-point-laser-channel min-delay") {};
+
+    void DoRun () {
+        Ptr<MobilityModel> a = CreateSatelliteMobility(0);
+        Ptr<MobilityModel> b = CreateSatelliteMobility(1);
+        Ptr<TestPointToPointLaserChannel> channel = CreateObject<TestPointToPointLaserChannel>();
+
+        // Positive for a real ISL
+        Time min_delay = channel->GetMinDelay(a, b, Seconds(100), Seconds(1));
+        ASSERT_TRUE(min_delay.IsStrictlyPositive());
+
+        // The exact delay sampled much finer never goes below it
+        double delay_ns;
+        double lowest_delay_ns = 1e18;
+        for (int64_t t_ns = 0; t_ns <= 100000000000; t_ns += 1000000) {
+            ASSERT_TRUE(channel->GetDelayAt(a, b, t_ns, &delay_ns));
+            ASSERT_TRUE(delay_ns >= min_delay.GetNanoSeconds());
+            lowest_delay_ns = std::min(lowest_delay_ns, delay_ns);
+        }
+
+        // Not needlessly far below it either (the satellites approach each other at most 2 * 11186 m/s)
+        ASSERT_TRUE(lowest_delay_ns - min_delay.GetNanoSeconds() < 2 * 11186.0 / 299792458.0 * 1e9);
+
+        // A coarser sample interval, which does not divide the time span
+        Time min_delay_uneven = channel->GetMinDelay(a, b, Seconds(100), Seconds(3));
+        ASSERT_TRUE(min_delay_uneven.IsStrictlyPositive());
+        ASSERT_TRUE(min_delay_uneven <= min_delay + Seconds(2 * 11186.0 * 3 / 299792458.0));
+
+        // Unknown positions over time result in 0, which makes the helper abort for a remote ISL
+        Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel>();
+        moving->SetPosition(Vector(7000000, 0, 0));
+        moving->SetVelocity(Vector(0, 7000, 0));
+        ASSERT_EQUAL(channel->GetMinDelay(a, moving, Seconds(100), Seconds(1)), Seconds(0));
+        ASSERT_EQUAL(channel->GetMinDelay(moving, b, Seconds(100), Seconds(1)), Seconds(0));
+
+        // Constant positions are known at any time
+        Ptr<ConstantPositionMobilityModel> fixed = CreateObject<ConstantPositionMobilityModel>();
+        fixed->SetPosition(Vector(0, 0, 0));
+        ASSERT_TRUE(channel->GetMinDelay(a, fixed, Seconds(100), Seconds(1)).IsStrictlyPositive());
+
+        Simulator::Destroy();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PointToPointLaserRemoteChannelLookaheadTestCase : public PointToPointLaserChannelTestCase {
+public:
+    PointToPointLaserRemoteChannelLookaheadTestCase () : PointToPointLaserChannelTestCase ("point-to-point-laser-channel remote-lookahead") {};
+
+    std::vector<Time> remote_delays;
+    std::vector<Time> exact_delays;
+    std::vector<Time> local_delays;
+
+    void DoRun () {
+        Ptr<MobilityModel> a = CreateSatelliteMobility(0);
+        Ptr<MobilityModel> b = CreateSatelliteMobility(1);
+
+        // Remote channel as installed by the helper, with the delay model enabled as well
+        Ptr<TestPointToPointLaserRemoteChannel> remote = CreateObject<TestPointToPointLaserRemoteChannel>();
+        remote->SetAttribute("DelayModelMaxError", TimeValue(NanoSeconds(100)));
+        Time lookahead = remote->GetMinDelay(a, b, Seconds(100), Seconds(1));
+        ASSERT_TRUE(lookahead.IsStrictlyPositive());
+        remote->SetAttribute("Delay", TimeValue(lookahead));
+        ASSERT_EQUAL(remote->GetLowerBoundDelay(), lookahead);
+
+        // Local channel with the same delay model
+        Ptr<TestPointToPointLaserChannel> local = CreateObject<TestPointToPointLaserChannel>();
+        local->SetAttribute("DelayModelMaxError", TimeValue(NanoSeconds(100)));
+
+        // Delays during the entire lookahead window
+        for (int64_t t_ns = 0; t_ns <= 100000000000; t_ns += 10000000) {
+            Simulator::Schedule(NanoSeconds(t_ns), [this, remote, local, a, b]() {
+                remote_delays.push_back(remote->GetDelay(a, b));
+                exact_delays.push_back(remote->GetExactDelay(a, b));
+                local_delays.push_back(local->GetDelay(a, b));
+            });
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // The remote channel does not use the delay model, so never goes below the lookahead,
+        // whereas the local channel does use the delay model
+        ASSERT_EQUAL(remote_delays.size(), 10001);
+        bool local_predicted = false;
+        for (size_t i = 0; i < remote_delays.size(); i++) {
+            ASSERT_EQUAL(remote_delays[i], exact_delays[i]);
+            ASSERT_TRUE(remote_delays[i] >= lookahead);
+            ASSERT_TRUE(Abs(local_delays[i] - exact_delays[i]) <= NanoSeconds(100));
+            local_predicted = local_predicted || local_delays[i] != exact_delays[i];
+        }
+        ASSERT_TRUE(local_predicted);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class PointToPointLaserChannelDelayModelTestCase : public PointToPointLaserChannelTestCase {
+public:
+    PointToPointLaserChannelDelayModelTestCase () : PointToPointLaserChannelTestCase ("point-to-point-laser-channel delay-model") {};
+
+    std::vector<Time> predicted_delays;
+    std::vector<Time> exact_delays;
+    std::vector<Time> default_delays;
+    std::vector<Time> distance_delays;
+
+    // Delays every step from 0 up to and including the end
+    void SampleDelays(Ptr<TestPointToPointLaserChannel> predicted, Ptr<TestPointToPointLaserChannel> exact,
+                      Ptr<MobilityModel> a, Ptr<MobilityModel> b, int64_t end_ns, int64_t step_ns) {
+        predicted_delays.clear();
+        exact_delays.clear();
+        default_delays.clear();
+        distance_delays.clear();
+        for (int64_t t_ns = 0; t_ns <= end_ns; t_ns += step_ns) {
+            Simulator::Schedule(NanoSeconds(t_ns), [this, predicted, exact, a, b]() {
+                predicted_delays.push_back(predicted->GetDelay(a, b));
+                exact_delays.push_back(predicted->GetExactDelay(a, b));
+                default_delays.push_back(exact->GetDelay(a, b));
+                distance_delays.push_back(Seconds(a->GetDistanceFrom(b) / 299792458.0));
+            });
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+    }
+
+    void DoRun () {
+
+        // Segments of at most 10s over a minute, so it is refitted at least six times
+        Ptr<MobilityModel> a = CreateSatelliteMobility(0);
+        Ptr<MobilityModel> b = CreateSatelliteMobility(1);
+        Ptr<TestPointToPointLaserChannel> predicted = CreateObject<TestPointToPointLaserChannel>();
+        predicted->SetAttribute("DelayModelMaxError", TimeValue(NanoSeconds(50)));
+        predicted->SetAttribute("DelayModelMaxSegment", TimeValue(Seconds(10)));
+        Ptr<TestPointToPointLaserChannel> exact = CreateObject<TestPointToPointLaserChannel>();
+        SampleDelays(predicted, exact, a, b, 60000000000, 1000000);
+        ASSERT_EQUAL(predicted_delays.size(), 60001);
+        bool any_predicted = false;
+        for (size_t i = 0; i < predicted_delays.size(); i++) {
+
+            // Prediction is within the maximum error (and rounding to ns) of distance / c
+            ASSERT_TRUE(Abs(predicted_delays[i] - distance_delays[i]) <= NanoSeconds(51));
+            any_predicted = any_predicted || predicted_delays[i] != distance_delays[i];
+
+            // Without maximum error, it is exactly distance / c as before the delay model
+            ASSERT_EQUAL(default_delays[i], distance_delays[i]);
+            ASSERT_EQUAL(exact_delays[i], distance_delays[i]);
+
+        }
+        ASSERT_TRUE(any_predicted);
+
+        // Two satellites in the same shell but crossing planes, which are at the same place
+        // at the TLE epoch, which is half a millisecond into the simulation. The delay has
+        // a kink there (|t - 0.5ms| * 30 ns/ms), which no cubic fits within 1 ns, not even
+        // over a segment of the shortest length (1 ms): over it, the exact delay is used.
+        Ptr<MobilityModel> c = CreateSatelliteMobility(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08",
+                MicroSeconds(500)
+        );
+        Ptr<MobilityModel> d = CreateSatelliteMobility(
+                "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+                "2 00002 127.0000   0.0000 0000001   0.0000   0.0000 15.19000000    09",
+                MicroSeconds(500)
+        );
+        Ptr<TestPointToPointLaserChannel> crossing = CreateObject<TestPointToPointLaserChannel>();
+        crossing->SetAttribute("DelayModelMaxError", TimeValue(NanoSeconds(1)));
+        SampleDelays(crossing, exact, c, d, 3000000, 50000);
+        ASSERT_EQUAL(predicted_delays.size(), 61);
+        ASSERT_TRUE(exact_delays[10] < NanoSeconds(1));
+        ASSERT_TRUE(exact_delays[0] > NanoSeconds(10));
+        for (size_t i = 0; i < 20; i++) {
+            ASSERT_EQUAL(predicted_delays[i], exact_delays[i]);
+        }
+
+        // After the kink the delay is smooth again, and the segments grow again
+        for (size_t i = 20; i < predicted_delays.size(); i++) {
+            ASSERT_TRUE(Abs(predicted_delays[i] - exact_delays[i]) <= NanoSeconds(2));
+        }
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,401 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <fstream>
+#include <sstream>
+
+#include "ns3/core-module.h"
+#include "ns3/basic-simulation.h"
+#include "ns3/topology-satellite-network.h"
+#include "ns3/ipv4-arbiter-routing-helper.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/satellite-ephemeris.h"
+#include "ns3/satellite-ephemeris-mobility-model.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteEphemerisTestCase : public TestCase {
+public:
+    SatelliteEphemerisTestCase (std::string s) : TestCase (s) {};
+
+    const std::vector<std::pair<std::string, std::string>> tles = {
+
+        // ISS (near-Earth, epoch in 2020)
+        std::make_pair(
+            "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+            "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+        ),
+
+        // Generated shell satellites (as by satgenpy, epoch in 2000)
+        std::make_pair(
+            "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+            "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08"
+        ),
+        std::make_pair(
+            "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+            "2 00002  53.0000  45.0000 0000001   0.0000 120.0000 15.19000000    01"
+        )
+
+    };
+
+    Ptr<Satellite> CreateSatellite(size_t i) {
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName("Satellite " + std::to_string(i));
+        satellite->SetTleInfo(tles[i].first, tles[i].second);
+        return satellite;
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteEphemerisMobilityModelTestCase : public SatelliteEphemerisTestCase {
+public:
+    SatelliteEphemerisMobilityModelTestCase () : SatelliteEphemerisTestCase ("satellite-ephemeris mobility-model") {};
+
+    std::vector<Vector> exact_positions, exact_velocities;
+    std::vector<Vector> interpolated_positions, interpolated_velocities;
+
+    void DoRun () {
+
+        // Both mobility models of every satellite, the ephemeris one sampled every 10s over 600s
+        std::vector<Ptr<SatellitePositionMobilityModel>> exact;
+        std::vector<Ptr<SatelliteEphemerisMobilityModel>> interpolated;
+        for (size_t i = 0; i < tles.size(); i++) {
+            Ptr<Satellite> satellite = CreateSatellite(i);
+            exact.push_back(CreateObject<SatellitePositionMobilityModel>());
+            exact.back()->SetAttribute("SatellitePositionHelper", SatellitePositionHelperValue(SatellitePositionHelper(satellite)));
+            interpolated.push_back(CreateObject<SatelliteEphemerisMobilityModel>());
+            interpolated.back()->SetAttribute("SatellitePositionHelper", SatellitePositionHelperValue(SatellitePositionHelper(satellite)));
+            interpolated.back()->SetSampleInterval(Seconds(10));
+            ASSERT_FALSE(interpolated.back()->IsBuilt());
+            interpolated.back()->Build(Seconds(600));
+            ASSERT_TRUE(interpolated.back()->IsBuilt());
+            ASSERT_EQUAL(interpolated.back()->GetEphemeris()->GetNSamples(), 61);
+            ASSERT_TRUE(interpolated.back()->GetErrorBound() > 0.0);
+            ASSERT_TRUE(interpolated.back()->GetErrorBound() < 1.0);
+        }
+
+        // Every 0.7s (in between and on the grid), and beyond the last sample
+        for (int64_t t_ms = 0; t_ms <= 700000; t_ms += 700) {
+            Simulator::Schedule(MilliSeconds(t_ms), [this, exact, interpolated]() {
+                for (size_t i = 0; i < exact.size(); i++) {
+                    exact_positions.push_back(exact[i]->GetPosition());
+                    exact_velocities.push_back(exact[i]->GetVelocity());
+                    interpolated_positions.push_back(interpolated[i]->GetPosition());
+                    interpolated_velocities.push_back(interpolated[i]->GetVelocity());
+                }
+            });
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+
+        size_t n = tles.size();
+        ASSERT_EQUAL(exact_positions.size(), 1001 * n);
+        for (size_t j = 0; j < exact_positions.size(); j++) {
+            int64_t t_ms = (j / n) * 700;
+            double error_bound = interpolated[j % n]->GetEphemeris()->GetMaxErrorBound();
+            double position_error = CalculateDistance(interpolated_positions[j], exact_positions[j]);
+            double velocity_error = CalculateDistance(interpolated_velocities[j], exact_velocities[j]);
+            if (t_ms % 10000 == 0 && t_ms <= 600000) {
+
+                // On a sample it is (up to the batch propagator) the same
+                ASSERT_TRUE(position_error < 1e-3);
+                ASSERT_TRUE(velocity_error < 1e-6);
+
+            } else if (t_ms < 600000) {
+
+                // In between, within the error bound (which is measured at the midpoints,
+                // where the error is largest), and the velocity within 1 mm/s
+                ASSERT_TRUE(position_error <= error_bound * 1.05);
+                ASSERT_TRUE(velocity_error < 1e-3);
+
+            } else {
+
+                // Beyond the last sample it falls back to exact SGP4
+                ASSERT_EQUAL(position_error, 0.0);
+                ASSERT_EQUAL(velocity_error, 0.0);
+
+            }
+        }
+
+        // At the last sample, and beyond
+        ASSERT_TRUE(CalculateDistance(interpolated[0]->GetPositionAt(Seconds(600)), exact[0]->GetPositionAt(Seconds(600))) < 1e-3);
+        ASSERT_EQUAL(CalculateDistance(interpolated[0]->GetPositionAt(Seconds(600.5)), exact[0]->GetPositionAt(Seconds(600.5))), 0.0);
+        ASSERT_EQUAL(CalculateDistance(interpolated[0]->GetPositionAt(Seconds(-1)), exact[0]->GetPositionAt(Seconds(-1))), 0.0);
+
+        // Without an orbit (as when the ephemeris is loaded from a file), it holds the
+        // position at the edge of the sampled range; the current position there aborts
+        Ptr<SatelliteEphemerisMobilityModel> no_orbit = CreateObject<SatelliteEphemerisMobilityModel>();
+        no_orbit->SetSatellite(CreateObject<Satellite>());
+        no_orbit->SetEphemeris(interpolated[0]->GetEphemeris(), 0);
+        ASSERT_EQUAL(CalculateDistance(no_orbit->GetPositionAt(Seconds(123.4)), interpolated[0]->GetPositionAt(Seconds(123.4))), 0.0);
+        ASSERT_EQUAL(CalculateDistance(no_orbit->GetPositionAt(Seconds(600)), interpolated[0]->GetPositionAt(Seconds(600))), 0.0);
+        ASSERT_EQUAL(CalculateDistance(no_orbit->GetPositionAt(Seconds(700)), interpolated[0]->GetPositionAt(Seconds(600))), 0.0);
+        ASSERT_EQUAL(CalculateDistance(no_orbit->GetPositionAt(Seconds(-1)), interpolated[0]->GetPositionAt(Seconds(0))), 0.0);
+
+        // Changing the satellite or start time discards the samples
+        interpolated[0]->SetStartTime(interpolated[0]->GetStartTime() + Seconds(1));
+        ASSERT_FALSE(interpolated[0]->IsBuilt());
+        ASSERT_EQUAL(interpolated[0]->GetErrorBound(), 0.0);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteEphemerisBuildThreadsTestCase : public SatelliteEphemerisTestCase {
+public:
+    SatelliteEphemerisBuildThreadsTestCase () : SatelliteEphemerisTestCase ("satellite-ephemeris build-threads") {};
+
+    // Both ephemerides must hold exactly the same samples and error bounds
+    void AssertIdentical(Ptr<SatelliteEphemeris> a, Ptr<SatelliteEphemeris> b) {
+        ASSERT_EQUAL(a->GetNSatellites(), b->GetNSatellites());
+        ASSERT_EQUAL(a->GetNSamples(), b->GetNSamples());
+        ASSERT_EQUAL(a->GetInterval(), b->GetInterval());
+        for (uint32_t i = 0; i < a->GetNSatellites(); i++) {
+            ASSERT_EQUAL(a->GetErrorBound(i), b->GetErrorBound(i));
+            for (uint32_t k = 0; k < 2 * (a->GetNSamples() - 1) + 1; k++) {
+                Time t = a->GetInterval() * (int64_t) k / 2;
+                Vector position_a, velocity_a, position_b, velocity_b;
+                ASSERT_TRUE(a->Interpolate(i, t, &position_a, &velocity_a));
+                ASSERT_TRUE(b->Interpolate(i, t, &position_b, &velocity_b));
+                ASSERT_EQUAL(position_a.x, position_b.x);
+                ASSERT_EQUAL(position_a.y, position_b.y);
+                ASSERT_EQUAL(position_a.z, position_b.z);
+                ASSERT_EQUAL(velocity_a.x, velocity_b.x);
+                ASSERT_EQUAL(velocity_a.y, velocity_b.y);
+                ASSERT_EQUAL(velocity_a.z, velocity_b.z);
+            }
+        }
+    }
+
+    void DoRun () {
+
+        // Four satellites in three (start, epoch) groups: the ISS, the two shell satellites
+        // (which share their epoch) starting at it, and the first of those starting 90s later
+        std::vector<Ptr<Satellite>> satellites;
+        std::vector<JulianDate> starts;
+        for (size_t i = 0; i < tles.size(); i++) {
+            satellites.push_back(CreateSatellite(i));
+            starts.push_back(satellites.back()->GetTleEpoch());
+        }
+        satellites.push_back(CreateSatellite(1));
+        starts.push_back(satellites.back()->GetTleEpoch() + Seconds(90));
+
+        // 100 intervals with one thread
+        Ptr<SatelliteEphemeris> single = SatelliteEphemeris::Build(satellites, starts, Seconds(1000), Seconds(10), 1);
+        ASSERT_EQUAL(single->GetNSatellites(), 4);
+        ASSERT_EQUAL(single->GetNSamples(), 101);
+
+        // Each sample is that of its own satellite and start
+        for (uint32_t i = 0; i < satellites.size(); i++) {
+            SatellitePositionHelper helper(satellites[i], starts[i]);
+            Vector position;
+            ASSERT_TRUE(single->Interpolate(i, Seconds(370), &position, 0));
+            ASSERT_TRUE(CalculateDistance(position, helper.GetPosition(Seconds(370))) < 1e-3);
+        }
+
+        // Split over threads: evenly, unevenly, one per core, and more threads than intervals
+        AssertIdentical(single, SatelliteEphemeris::Build(satellites, starts, Seconds(1000), Seconds(10), 4));
+        AssertIdentical(single, SatelliteEphemeris::Build(satellites, starts, Seconds(1000), Seconds(10), 7));
+        AssertIdentical(single, SatelliteEphemeris::Build(satellites, starts, Seconds(1000), Seconds(10), 0));
+        AssertIdentical(single, SatelliteEphemeris::Build(satellites, starts, Seconds(1000), Seconds(10), 250));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteEphemerisFileTestCase : public SatelliteEphemerisTestCase {
+public:
+    SatelliteEphemerisFileTestCase () : SatelliteEphemerisTestCase ("satellite-ephemeris file") {};
+
+    const std::string temp_dir = ".tmp-satellite-ephemeris-file-test";
+
+    std::string ReadBytes(const std::string& filename) {
+        std::ifstream ifs(filename, std::ios::binary);
+        std::stringstream buffer;
+        buffer << ifs.rdbuf();
+        return buffer.str();
+    }
+
+    void WriteBytes(const std::string& filename, const std::string& bytes) {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs.write(bytes.data(), bytes.size());
+    }
+
+    // Ephemeris of the given TLE lines, starting at their epoch (as main_satnet_ephemeris)
+    Ptr<SatelliteEphemeris> BuildEphemeris(const std::vector<std::pair<std::string, std::string>>& satellite_tles) {
+        std::vector<Ptr<Satellite>> satellites;
+        std::vector<JulianDate> starts;
+        for (const std::pair<std::string, std::string>& tle : satellite_tles) {
+            satellites.push_back(CreateObject<Satellite>());
+            satellites.back()->SetTleInfo(tle.first, tle.second);
+            starts.push_back(satellites.back()->GetTleEpoch());
+        }
+        return SatelliteEphemeris::Build(satellites, starts, Seconds(100), Seconds(10), 2);
+    }
+
+    // Run directory of the end-to-end-special test topology (without routes), which
+    // maps the ephemeris file
+    const std::vector<std::pair<std::string, std::string>> run_tles = {
+        std::make_pair(
+            "1 01478U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    03",
+            "2 01478  53.0000 335.0000 0000001   0.0000  57.2727 15.19000000    08"
+        ),
+        std::make_pair(
+            "1 01500U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    09",
+            "2 01500  53.0000 340.0000 0000001   0.0000  49.0909 15.19000000    01"
+        ),
+        std::make_pair(
+            "1 01544U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    07",
+            "2 01544  53.0000 350.0000 0000001   0.0000  49.0909 15.19000000    00"
+        )
+    };
+
+    void PrepareRunDir() {
+        std::ofstream config_file(temp_dir + "/config_ns3.properties");
+        config_file << "simulation_end_time_ns=100000000" << std::endl;
+        config_file << "simulation_seed=987654321" << std::endl;
+        config_file << "satellite_network_dir=." << std::endl;
+        config_file << "satellite_network_routes_dir=." << std::endl;
+        config_file << "satellite_ephemeris_file=ephemeris.bin" << std::endl;
+        config_file << "isl_data_rate_megabit_per_s=4.00" << std::endl;
+        config_file << "gsl_data_rate_megabit_per_s=10.00" << std::endl;
+        config_file << "isl_max_queue_size_pkts=80" << std::endl;
+        config_file << "gsl_max_queue_size_pkts=75" << std::endl;
+        config_file << "dynamic_state_update_interval_ns=100000000" << std::endl;
+        config_file.close();
+
+        std::ofstream tles_file(temp_dir + "/tles.txt");
+        tles_file << "1 3" << std::endl;
+        for (size_t i = 0; i < run_tles.size(); i++) {
+            tles_file << "Starlink-550 " << i << std::endl;
+            tles_file << run_tles[i].first << std::endl;
+            tles_file << run_tles[i].second << std::endl;
+        }
+        tles_file.close();
+
+        std::ofstream isls_file(temp_dir + "/isls.txt");
+        isls_file << "0 1" << std::endl;
+        isls_file.close();
+
+        std::ofstream ground_stations_file(temp_dir + "/ground_stations.txt");
+        ground_stations_file << "0,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "1,New-York-Newark,40.717042,-74.003663,0.000000,1334103.172127,-4653693.528901,4138656.197504" << std::endl;
+        ground_stations_file << "2,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file << "3,Atlanta,33.760000,-84.400000,0.000000,517979.453140,-5282763.124122,3524344.845288" << std::endl;
+        ground_stations_file.close();
+
+        std::ofstream gsl_interfaces_info_file(temp_dir + "/gsl_interfaces_info.txt");
+        gsl_interfaces_info_file << "0,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "1,2,2.0" << std::endl;
+        gsl_interfaces_info_file << "2,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "3,2,1.0" << std::endl;
+        gsl_interfaces_info_file << "4,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "5,1,1.0" << std::endl;
+        gsl_interfaces_info_file << "6,1,1.0" << std::endl;
+        gsl_interfaces_info_file.close();
+    }
+
+    // Returns whether building the topology (which loads the ephemeris file) threw an exception
+    bool LoadTopology() {
+        Ptr<BasicSimulation> basicSimulation = CreateObject<BasicSimulation>(temp_dir);
+        bool thrown = false;
+        try {
+            CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
+        } catch (std::exception& e) {
+            thrown = true;
+        }
+        basicSimulation->Finalize();
+        return thrown;
+    }
+
+    void DoRun () {
+        mkdir_if_not_exists(temp_dir);
+        const std::string filename = temp_dir + "/ephemeris.bin";
+
+        // Round trip
+        Ptr<SatelliteEphemeris> built = BuildEphemeris(tles);
+        ASSERT_FALSE(built->IsMapped());
+        built->Save(filename);
+        Ptr<SatelliteEphemeris> loaded = SatelliteEphemeris::Load(filename);
+        ASSERT_TRUE(loaded->IsMapped());
+        ASSERT_EQUAL(loaded->GetNSatellites(), 3);
+        ASSERT_EQUAL(loaded->GetNSamples(), built->GetNSamples());
+        ASSERT_EQUAL(loaded->GetInterval(), Seconds(10));
+        for (uint32_t i = 0; i < 3; i++) {
+            ASSERT_EQUAL(loaded->GetErrorBound(i), built->GetErrorBound(i));
+            ASSERT_EQUAL(loaded->GetTleEpoch(i), built->GetTleEpoch(i));
+            ASSERT_EQUAL(loaded->GetTleHash(i), built->GetTleHash(i));
+            ASSERT_EQUAL(loaded->GetTleHash(i), SatelliteEphemeris::HashTle(tles[i].first, tles[i].second));
+            for (int64_t t_ms = 0; t_ms <= 100000; t_ms += 2500) {
+                Vector position_built, velocity_built, position_loaded, velocity_loaded;
+                ASSERT_TRUE(built->Interpolate(i, MilliSeconds(t_ms), &position_built, &velocity_built));
+                ASSERT_TRUE(loaded->Interpolate(i, MilliSeconds(t_ms), &position_loaded, &velocity_loaded));
+                ASSERT_EQUAL(CalculateDistance(position_built, position_loaded), 0.0);
+                ASSERT_EQUAL(CalculateDistance(velocity_built, velocity_loaded), 0.0);
+            }
+        }
+        ASSERT_EQUAL(loaded->GetTleEpoch(0), 20274.52061263);
+        ASSERT_EQUAL(loaded->GetTleEpoch(1), 1.0);
+        ASSERT_NOT_EQUAL(loaded->GetTleHash(1), loaded->GetTleHash(2));
+        loaded = 0; // Unmapped before the file is overwritten
+
+        // Rejected: missing, corrupt magic or version, and any other size than in the header
+        const std::string bytes = ReadBytes(filename);
+        const std::string corrupt_filename = temp_dir + "/corrupt.bin";
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(temp_dir + "/does-not-exist.bin"));
+        std::string corrupt = bytes;
+        corrupt[7] = 'X';
+        WriteBytes(corrupt_filename, corrupt);
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(corrupt_filename));
+        corrupt = bytes;
+        corrupt[8] = 1;
+        WriteBytes(corrupt_filename, corrupt);
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(corrupt_filename));
+        WriteBytes(corrupt_filename, bytes.substr(0, bytes.size() - 8));
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(corrupt_filename));
+        WriteBytes(corrupt_filename, bytes + std::string(1, '\0'));
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(corrupt_filename));
+        WriteBytes(corrupt_filename, bytes.substr(0, 20));
+        ASSERT_EXCEPTION(SatelliteEphemeris::Load(corrupt_filename));
+        WriteBytes(corrupt_filename, bytes);
+        ASSERT_TRUE(SatelliteEphemeris::Load(corrupt_filename)->IsMapped());
+
+        // The topology accepts the ephemeris of its own TLEs
+        PrepareRunDir();
+        BuildEphemeris(run_tles)->Save(filename);
+        ASSERT_FALSE(LoadTopology());
+
+        // But not one of a TLE with another epoch, or another orbit with the same epoch
+        std::vector<std::pair<std::string, std::string>> other_tles = run_tles;
+        other_tles[2].first = "1 01544U 00000ABC 00002.00000000  .00000000  00000-0  00000+0 0    07";
+        BuildEphemeris(other_tles)->Save(filename);
+        ASSERT_TRUE(LoadTopology());
+        other_tles = run_tles;
+        other_tles[1].second = "2 01500  53.0000 340.0000 0000001   0.0000  49.0910 15.19000000    01";
+        BuildEphemeris(other_tles)->Save(filename);
+        ASSERT_TRUE(LoadTopology());
+
+        // Nor one of another number of satellites
+        other_tles = run_tles;
+        other_tles.pop_back();
+        BuildEphemeris(other_tles)->Save(filename);
+        ASSERT_TRUE(LoadTopology());
+
+        Simulator::Destroy();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,21 @@
 #include "satellite-info-test.h"
 #include "ground-station-info-test.h"
 #include "end-to-end-special-test.h"
+#include "sgp4-batch-propagator-test.h"
+#include "frame-transform-test.h"
+#include "satellite-state-test.h"
+#include "satellite-ephemeris-test.h"
+#include "satellite-position-cache-test.h"
+#include "gsl-net-device-test.h"
+#include "gsl-channel-test.h"
+#include "isl-utilization-tracking-test.h"
+#include "gsl-tracking-test.h"
+#include "channel-zero-copy-test.h"
+#include "arbiter-single-forward-test.h"
+#include "arbiter-single-forward-helper-test.h"
+#include "partition-nodes-to-systems-test.h"
+#include "point-to-point-laser-channel-test.h"
+#include "gsl-lookahead-test.h"
 
 using namespace ns3;
 
@@ -31,6 +46,37 @@ public:
         AddTestCase(new SatelliteInfoTestCase, TestCase::QUICK);
         AddTestCase(new GroundStationInfoTestCase, TestCase::QUICK);
 
+        // Satellite propagation
+        AddTestCase(new FrameTransformTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteGetStateTestCase, TestCase::QUICK);
+        AddTestCase(new Sgp4BatchPropagatorTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteEphemerisMobilityModelTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteEphemerisBuildThreadsTestCase, TestCase::QUICK);
+        AddTestCase(new SatelliteEphemerisFileTestCase, TestCase::QUICK);
+        AddTestCase(new SatellitePositionCacheTestCase, TestCase::QUICK);
+
+        // Distributed node-to-system-id assignment
+        AddTestCase(new PartitionNodesToSystemsTestCase, TestCase::QUICK);
+
+        // Forwarding state
+        AddTestCase(new ArbiterSingleForwardTableTestCase, TestCase::QUICK);
+        AddTestCase(new ArbiterSingleForwardHelperBinaryTestCase, TestCase::QUICK);
+
+        // Network devices
+        AddTestCase(new GslNetDeviceQueueDestinationsTestCase, TestCase::QUICK);
+        AddTestCase(new GslChannelDelayCacheTestCase, TestCase::QUICK);
+        AddTestCase(new IslUtilizationTrackingTestCase, TestCase::QUICK);
+        AddTestCase(new GslTrackingTestCase, TestCase::QUICK);
+        AddTestCase(new ChannelZeroCopyTestCase, TestCase::QUICK);
+
+        // ISL delay
+        AddTestCase(new PointToPointLaserChannelMinDelayTestCase, TestCase::QUICK);
+        AddTestCase(new PointToPointLaserRemoteChannelLookaheadTestCase, TestCase::QUICK);
+        AddTestCase(new PointToPointLaserChannelDelayModelTestCase, TestCase::QUICK);
+
+        // GSL lookahead
+        AddTestCase(new GslLookaheadTestCase, TestCase::QUICK);
+
     }
 };
 static SatelliteNetworkTestSuite SatelliteNetworkTestSuite;
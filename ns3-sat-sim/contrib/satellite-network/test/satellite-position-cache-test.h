@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-cache.h"
+#include "ns3/satellite-position-mobility-model.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatellitePositionCacheTestCase : public TestCase {
+public:
+    SatellitePositionCacheTestCase () : TestCase ("satellite-position-cache quantum") {};
+
+    // Query times (ms) with a quantum of 100 ms: on a boundary, in between, and
+    // the same time twice; five quanta are entered (0, 1, 3, 10, 12)
+    const std::vector<int64_t> times_ms = {0, 30, 99, 100, 100, 150, 300, 1000, 1234};
+
+    // Per query time and satellite
+    std::vector<Vector> cached_positions, cached_velocities;
+    std::vector<Vector> exact_positions, exact_velocities;
+    std::vector<Vector> exact_positions_at_quantum_start;
+
+    void AssertSame(Vector a, Vector b) {
+        ASSERT_EQUAL(a.x, b.x);
+        ASSERT_EQUAL(a.y, b.y);
+        ASSERT_EQUAL(a.z, b.z);
+    }
+
+    void DoRun () {
+
+        // Two generated shell satellites (as by satgenpy)
+        const std::vector<std::pair<std::string, std::string>> tles = {
+            std::make_pair(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08"
+            ),
+            std::make_pair(
+                "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+                "2 00002  53.0000  45.0000 0000001   0.0000 120.0000 15.19000000    01"
+            )
+        };
+
+        // A cached and an uncached mobility model for each, the cached ones sharing the cache
+        Ptr<SatellitePositionCache> cache = CreateObject<SatellitePositionCache>();
+        cache->SetQuantum(MilliSeconds(100));
+        ASSERT_EQUAL(cache->GetQuantum(), MilliSeconds(100));
+        std::vector<Ptr<SatellitePositionMobilityModel>> cached, exact;
+        for (size_t i = 0; i < tles.size(); i++) {
+            Ptr<Satellite> satellite = CreateObject<Satellite>();
+            satellite->SetName("Satellite " + std::to_string(i));
+            satellite->SetTleInfo(tles[i].first, tles[i].second);
+            exact.push_back(CreateObject<SatellitePositionMobilityModel>());
+            exact.back()->SetAttribute("SatellitePositionHelper", SatellitePositionHelperValue(SatellitePositionHelper(satellite)));
+            cached.push_back(CreateObject<SatellitePositionMobilityModel>());
+            cached.back()->SetAttribute("SatellitePositionHelper", SatellitePositionHelperValue(SatellitePositionHelper(satellite)));
+            cached.back()->SetPositionCache(cache);
+            ASSERT_TRUE(cached.back()->GetPositionCache() == cache);
+            ASSERT_TRUE(exact.back()->GetPositionCache() == 0);
+        }
+
+        // Quantum arithmetic
+        ASSERT_EQUAL(cache->GetQuantumIndex(MilliSeconds(0)), 0);
+        ASSERT_EQUAL(cache->GetQuantumIndex(NanoSeconds(99999999)), 0);
+        ASSERT_EQUAL(cache->GetQuantumIndex(MilliSeconds(100)), 1);
+        ASSERT_EQUAL(cache->GetQuantumIndex(MilliSeconds(1234)), 12);
+        ASSERT_EQUAL(cache->GetQuantumStart(12), MilliSeconds(1200));
+
+        // Query both at each of the times
+        for (int64_t t_ms : times_ms) {
+            Simulator::Schedule(MilliSeconds(t_ms), [this, cache, cached, exact]() {
+                for (size_t i = 0; i < cached.size(); i++) {
+                    cached_positions.push_back(cached[i]->GetPosition());
+                    cached_velocities.push_back(cached[i]->GetVelocity());
+                    exact_positions.push_back(exact[i]->GetPosition());
+                    exact_velocities.push_back(exact[i]->GetVelocity());
+                    Time quantum_start = cache->GetQuantumStart(cache->GetQuantumIndex(Simulator::Now()));
+                    exact_positions_at_quantum_start.push_back(exact[i]->GetPositionAt(quantum_start));
+                }
+            });
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+
+        // Hit and miss counts: one miss per satellite per quantum entered, the
+        // other queries (position and velocity each count) are hits
+        size_t n = tles.size();
+        ASSERT_EQUAL(cache->GetMisses(), 5 * n);
+        ASSERT_EQUAL(cache->GetHits(), 2 * times_ms.size() * n - 5 * n);
+
+        ASSERT_EQUAL(cached_positions.size(), times_ms.size() * n);
+        for (size_t j = 0; j < cached_positions.size(); j++) {
+            int64_t t_ms = times_ms[j / n];
+
+            // Always the exact position at the start of the quantum
+            AssertSame(cached_positions[j], exact_positions_at_quantum_start[j]);
+
+            if (t_ms % 100 == 0) {
+
+                // On a quantum boundary it is the same as without the cache
+                AssertSame(cached_positions[j], exact_positions[j]);
+                AssertSame(cached_velocities[j], exact_velocities[j]);
+
+            } else {
+
+                // In between, it is that of the start of the quantum, which differs
+                // (about 7.5 m per ms) from the exact one
+                ASSERT_TRUE(CalculateDistance(cached_positions[j], exact_positions[j]) > 1.0);
+                if (t_ms < 1000) {
+                    size_t j_quantum_start = (t_ms < 100 ? 0 : 3) * n + j % n;
+                    AssertSame(cached_positions[j], exact_positions[j_quantum_start]);
+                    AssertSame(cached_velocities[j], exact_velocities[j_quantum_start]);
+                }
+
+            }
+        }
+
+        // Resetting the statistics
+        cache->ResetStatistics();
+        ASSERT_EQUAL(cache->GetHits(), 0);
+        ASSERT_EQUAL(cache->GetMisses(), 0);
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "ns3/core-module.h"
+#include "ns3/satellite.h"
+#include "ns3/frame-transform.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class SatelliteGetStateTestCase : public TestCase {
+public:
+    SatelliteGetStateTestCase () : TestCase ("satellite get-state") {};
+
+    std::vector<Vector> model_positions, model_velocities;
+    std::vector<Satellite::State> model_states;
+
+    void AssertSame(Vector a, Vector b) {
+        ASSERT_EQUAL(a.x, b.x);
+        ASSERT_EQUAL(a.y, b.y);
+        ASSERT_EQUAL(a.z, b.z);
+    }
+
+    void DoRun () {
+
+        // The ISS (2020) and a generated shell satellite (as by satgenpy, 2000)
+        const std::vector<std::pair<std::string, std::string>> tles = {
+            std::make_pair(
+                "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+                "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+            ),
+            std::make_pair(
+                "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+                "2 00002  53.0000  45.0000 0000001   0.0000 120.0000 15.19000000    01"
+            )
+        };
+
+        // Offsets from the TLE epoch: before, at, sub-millisecond, and up to a day after
+        const std::vector<int64_t> offsets_ns = {-600000000000, 0, 1, 123456789, 5400000000000, 86400000000000};
+
+        std::vector<Ptr<SatellitePositionMobilityModel>> models;
+        for (size_t i = 0; i < tles.size(); i++) {
+            Ptr<Satellite> satellite = CreateObject<Satellite>();
+            satellite->SetTleInfo(tles[i].first, tles[i].second);
+            JulianDate epoch = satellite->GetTleEpoch();
+
+            for (int64_t offset_ns : offsets_ns) {
+
+                // At a Julian date (millisecond resolution)
+                JulianDate t = offset_ns >= 0 ? epoch + MilliSeconds(offset_ns / 1000000) : epoch - MilliSeconds(-offset_ns / 1000000);
+                Satellite::State state = satellite->GetState(t);
+                AssertSame(state.position, satellite->GetPosition(t));
+                AssertSame(state.velocity, satellite->GetVelocity(t));
+                ASSERT_TRUE(state.position.GetLength() > 6000000.0);
+                ASSERT_TRUE(state.velocity.GetLength() > 6000.0);
+
+                // At a time since epoch with its transform (nanosecond resolution)
+                FrameTransform transform(epoch, offset_ns);
+                double tsince = offset_ns / 60e9;
+                Satellite::State state_tsince = satellite->GetState(tsince, transform);
+                AssertSame(state_tsince.position, satellite->GetPosition(tsince, transform));
+                AssertSame(state_tsince.velocity, satellite->GetVelocity(tsince, transform));
+
+                // Via the position helper (starting at the epoch)
+                SatellitePositionHelper helper(satellite);
+                Satellite::State state_helper = helper.GetState(NanoSeconds(offset_ns));
+                AssertSame(state_helper.position, helper.GetPosition(NanoSeconds(offset_ns)));
+                AssertSame(state_helper.velocity, helper.GetVelocity(NanoSeconds(offset_ns)));
+
+            }
+
+            // Via the mobility model
+            models.push_back(CreateObject<SatellitePositionMobilityModel>());
+            models.back()->SetAttribute("SatellitePositionHelper", SatellitePositionHelperValue(SatellitePositionHelper(satellite)));
+        }
+
+        // Mobility model at simulation times, of which the first is in between two milliseconds
+        for (int64_t t_ns : std::vector<int64_t>({1500001, 60000000000})) {
+            Simulator::Schedule(NanoSeconds(t_ns), [this, models]() {
+                for (Ptr<SatellitePositionMobilityModel> model : models) {
+                    model_states.push_back(model->GetState());
+                    model_positions.push_back(model->GetPosition());
+                    model_velocities.push_back(model->GetVelocity());
+                }
+            });
+        }
+        Simulator::Run();
+        Simulator::Destroy();
+        ASSERT_EQUAL(model_states.size(), 2 * tles.size());
+        for (size_t j = 0; j < model_states.size(); j++) {
+            AssertSame(model_states[j].position, model_positions[j]);
+            AssertSame(model_states[j].velocity, model_velocities[j]);
+        }
+
+        // Not initialized: all zero, same as the separate calls
+        Ptr<Satellite> uninitialized = CreateObject<Satellite>();
+        JulianDate t = JulianDate(10957, 0);
+        Satellite::State state = uninitialized->GetState(t);
+        AssertSame(state.position, uninitialized->GetPosition(t));
+        AssertSame(state.velocity, uninitialized->GetVelocity(t));
+        AssertSame(state.position, Vector(0, 0, 0));
+        AssertSame(state.velocity, Vector(0, 0, 0));
+
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
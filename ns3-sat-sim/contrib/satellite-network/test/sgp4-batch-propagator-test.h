@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "ns3/satellite.h"
+#include "ns3/sgp4-batch-propagator.h"
+#include "ns3/sgp4unit.h"
+
+#include "ns3/test.h"
+#include "test-helpers.h"
+
+using namespace ns3;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+class Sgp4BatchPropagatorTestCase : public TestCase {
+public:
+    Sgp4BatchPropagatorTestCase () : TestCase ("sgp4-batch-propagator") {};
+
+    void DoRun () {
+
+        std::vector<std::pair<std::string, std::string>> tles = {
+
+            // ISS (near-Earth)
+            std::make_pair(
+                "1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+                "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"
+            ),
+
+            // GPS (deep-space, takes the scalar path)
+            std::make_pair(
+                "1 28129U 03058A   06175.57071136 -.00000104  00000-0  10000-3 0   459",
+                "2 28129  54.7298 324.8098 0048506 266.2640  93.1663  2.00562768 18443"
+            ),
+
+            // Generated shell satellites (as by satgenpy)
+            std::make_pair(
+                "1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+                "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08"
+            ),
+            std::make_pair(
+                "1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+                "2 00002  53.0000  45.0000 0000001   0.0000 120.0000 15.19000000    01"
+            ),
+
+            // Generated very low satellite (perigee below 220 km, simplified drag model)
+            std::make_pair(
+                "1 00003U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    06",
+                "2 00003  53.0000  90.0000 0000001   0.0000 240.0000 16.20000000    08"
+            )
+
+        };
+
+        // Add all satellites to the batch
+        std::vector<elsetrec> records;
+        Sgp4BatchPropagator batch(Satellite::WGeoSys);
+        for (size_t i = 0; i < tles.size(); i++) {
+            Ptr<Satellite> satellite = CreateObject<Satellite>();
+            satellite->SetName("Satellite " + std::to_string(i));
+            ASSERT_TRUE(satellite->SetTleInfo(tles[i].first, tles[i].second));
+            records.push_back(satellite->GetSgp4Record());
+            ASSERT_EQUAL(batch.Add(satellite->GetSgp4Record()), (uint32_t) i);
+        }
+        ASSERT_EQUAL(batch.GetN(), (uint32_t) tles.size());
+        ASSERT_EQUAL(batch.GetNDeepSpace(), 1u);
+        ASSERT_EQUAL(records[4].isimp, 1);
+
+        // The batch must produce the same results as the scalar propagator
+        std::vector<double> r(3 * tles.size());
+        std::vector<double> v(3 * tles.size());
+        std::vector<int> error(tles.size());
+        for (double tsince = -120.0; tsince <= 2880.0; tsince += 7.3) {
+            batch.Propagate(tsince, r.data(), v.data(), error.data());
+            for (size_t i = 0; i < tles.size(); i++) {
+                double r_scalar[3], v_scalar[3];
+                sgp4(Satellite::WGeoSys, records[i], tsince, r_scalar, v_scalar);
+                ASSERT_EQUAL(error[i], records[i].error);
+                if (records[i].error == 0) {
+                    for (size_t k = 0; k < 3; k++) {
+                        ASSERT_EQUAL_APPROX(r[3 * i + k], r_scalar[k], 1e-9);
+                        ASSERT_EQUAL_APPROX(v[3 * i + k], v_scalar[k], 1e-12);
+                    }
+                }
+            }
+        }
+
+    }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
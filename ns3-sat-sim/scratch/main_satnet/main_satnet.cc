@@ -69,7 +69,7 @@ int main(int argc, char *argv[]) {
 
     // Read topology, and install routing arbiters
     Ptr<TopologySatelliteNetwork> topology = CreateObject<TopologySatelliteNetwork>(basicSimulation, Ipv4ArbiterRoutingHelper());
-    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes());
+    ArbiterSingleForwardHelper arbiterHelper(basicSimulation, topology->GetNodes(), topology->GetEndpoints());
     GslIfBandwidthHelper gslIfBandwidthHelper(basicSimulation, topology->GetNodes());
 
     // Schedule flows
@@ -96,6 +96,9 @@ int main(int argc, char *argv[]) {
     // Collect utilization statistics
     topology->CollectUtilizationStatistics();
 
+    // Collect cache statistics
+    topology->CollectCacheStatistics();
+
     // Finalize the simulation
     basicSimulation->Finalize();
 
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+#include "ns3/core-module.h"
+#include "ns3/exp-util.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-ephemeris.h"
+
+using namespace ns3;
+
+/**
+ * Generates the binary ephemeris file of a constellation (tles.txt), which can be
+ * shared by all runs over that constellation via the satellite_ephemeris_file config key.
+ */
+int main(int argc, char *argv[]) {
+
+    // No buffering of printf
+    setbuf(stdout, nullptr);
+
+    // Arguments
+    CommandLine cmd;
+    std::string tles_file = "";
+    std::string output_file = "";
+    int64_t duration_ns = 0;
+    int64_t interval_ns = 10000000000;
+    uint32_t num_threads = 0;
+    cmd.Usage("Usage: ./ns3 --run=\"main_satnet_ephemeris --tles_file=<path/to/tles.txt> --output_file=<path/to/ephemeris.bin> --duration_ns=<duration>\"");
+    cmd.AddValue("tles_file", "Satellite network tles.txt", tles_file);
+    cmd.AddValue("output_file", "Ephemeris file to write", output_file);
+    cmd.AddValue("duration_ns", "Simulation time span to cover (ns), at least the simulation end time", duration_ns);
+    cmd.AddValue("interval_ns", "Interval between two samples (ns)", interval_ns);
+    cmd.AddValue("num_threads", "Number of threads (0 = number of cores)", num_threads);
+    cmd.Parse(argc, argv);
+    if (tles_file.compare("") == 0 || output_file.compare("") == 0 || duration_ns <= 0) {
+        printf("Usage: ./ns3 --run=\"main_satnet_ephemeris --tles_file=<path/to/tles.txt> --output_file=<path/to/ephemeris.bin> --duration_ns=<duration>\"\n");
+        return 1;
+    }
+
+    // Open file
+    std::ifstream fs;
+    fs.open(tles_file);
+    NS_ABORT_MSG_UNLESS(fs.is_open(), "File " + tles_file + " could not be opened");
+
+    // First line:
+    // <orbits> <satellites per orbit>
+    std::string orbits_and_n_sats_per_orbit;
+    std::getline(fs, orbits_and_n_sats_per_orbit);
+    std::vector<std::string> res = split_string(orbits_and_n_sats_per_orbit, " ", 2);
+    int64_t num_satellites = parse_positive_int64(res[0]) * parse_positive_int64(res[1]);
+
+    // Satellites, which start (as in the simulation) at their TLE epoch
+    std::vector<Ptr<Satellite>> satellites;
+    std::vector<JulianDate> starts;
+    std::string name, tle1, tle2;
+    while (std::getline(fs, name)) {
+        std::getline(fs, tle1);
+        std::getline(fs, tle2);
+        Ptr<Satellite> satellite = CreateObject<Satellite>();
+        satellite->SetName(name);
+        satellite->SetTleInfo(tle1, tle2);
+        satellites.push_back(satellite);
+        starts.push_back(satellite->GetTleEpoch());
+    }
+    fs.close();
+    if ((int64_t) satellites.size() != num_satellites) {
+        throw std::runtime_error("Number of satellites defined in the TLEs does not match");
+    }
+    std::cout << "Read " << satellites.size() << " satellites" << std::endl;
+
+    // Propagate
+    auto begin = std::chrono::steady_clock::now();
+    Ptr<SatelliteEphemeris> ephemeris = SatelliteEphemeris::Build(
+            satellites, starts, NanoSeconds(duration_ns), NanoSeconds(interval_ns), num_threads
+    );
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "Built ephemeris of " << ephemeris->GetNSamples() << " samples per satellite in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count() << " ms" << std::endl;
+    std::cout << "Max. interpolation error: " << ephemeris->GetMaxErrorBound() << " m" << std::endl;
+
+    // Write
+    ephemeris->Save(output_file);
+    std::cout << "Written to " << output_file << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,326 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/*
+ * Microbenchmark of the satellite propagation stack. For every TLE set, it
+ * measures the cost (ns/op) of:
+ *
+ *  - sgp4 (raw propagation, TEME)
+ *  - Satellite::GetPosition, GetVelocity and GetState
+ *  - TEME->ITRF frame transform, per call and shared per time instant
+ *  - JulianDate arithmetic (date + time, time between dates)
+ *  - SatellitePositionMobilityModel::GetDistanceFrom, with and without the
+ *    position cache (between consecutive satellites, in simulation events)
+ *
+ * The results are written as CSV:
+ *   tle_set,operation,num_satellites,num_ops,total_ns,ns_per_op,checksum
+ *
+ * TLE sets are files in the tles.txt format of satgenpy (first line
+ * "<orbits> <satellites per orbit>", then name and two TLE lines per
+ * satellite), e.g., the Starlink set in paper/satellite_networks_state/
+ * input_data/legacy or a Kuiper set generated by satgenpy. Without TLE sets,
+ * a few built-in near-Earth TLEs are used.
+ *
+ * Usage: ./ns3 run "satellite-propagation-bench --tles=<a/tles.txt>,<b/tles.txt>
+ *                   --steps=100 --output=bench.csv"
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/frame-transform.h"
+#include "ns3/julian-date.h"
+#include "ns3/nstime.h"
+#include "ns3/pointer.h"
+#include "ns3/ptr.h"
+#include "ns3/satellite.h"
+#include "ns3/satellite-position-cache.h"
+#include "ns3/satellite-position-helper.h"
+#include "ns3/satellite-position-mobility-model.h"
+#include "ns3/sgp4unit.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+namespace {
+
+/// Near-Earth TLEs (ISS and generated shell satellites)
+const char *BuiltinTles[][2] = {
+  {"1 25544U 98067A   20274.52061263  .00002472  00000-0  53335-4 0  9998",
+   "2 25544  51.6445 187.2657 0001412 107.7286  78.8629 15.48811122248346"},
+  {"1 00001U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    04",
+   "2 00001  53.0000   0.0000 0000001   0.0000   0.0000 15.19000000    08"},
+  {"1 00002U 00000ABC 00001.00000000  .00000000  00000-0  00000+0 0    05",
+   "2 00002  53.0000  45.0000 0000001   0.0000 120.0000 15.19000000    01"},
+};
+
+/**
+ * Read the satellites of a TLE set.
+ *
+ * @param filename  TLE set in tles.txt format ("" for the built-in TLEs)
+ *
+ * @return the satellites
+ */
+std::vector<Ptr<Satellite> >
+ReadTles (const std::string &filename)
+{
+  std::vector<Ptr<Satellite> > satellites;
+  if (filename.empty ())
+    {
+      for (uint32_t i = 0; i < sizeof (BuiltinTles) / sizeof (BuiltinTles[0]); i++)
+        {
+          Ptr<Satellite> satellite = CreateObject<Satellite> ();
+          satellite->SetName ("Satellite " + std::to_string (i));
+          satellite->SetTleInfo (BuiltinTles[i][0], BuiltinTles[i][1]);
+          satellites.push_back (satellite);
+        }
+      return satellites;
+    }
+
+  std::ifstream fs (filename.c_str ());
+  NS_ABORT_MSG_UNLESS (fs.is_open (), "TLE set " << filename << " could not be opened");
+  std::string line, name, tle1, tle2;
+  std::getline (fs, line);  // <orbits> <satellites per orbit>
+  while (std::getline (fs, name) && std::getline (fs, tle1) && std::getline (fs, tle2))
+    {
+      Ptr<Satellite> satellite = CreateObject<Satellite> ();
+      satellite->SetName (name);
+      satellite->SetTleInfo (tle1, tle2);
+      satellites.push_back (satellite);
+    }
+  NS_ABORT_MSG_IF (satellites.empty (), "TLE set " << filename << " has no satellites");
+  return satellites;
+}
+
+/// Writes one CSV line per measured operation
+class BenchWriter {
+public:
+  /**
+   * @param os      Output stream
+   * @param tleSet  Name of the TLE set
+   * @param n       Number of satellites
+   */
+  BenchWriter (std::ostream &os, const std::string &tleSet, uint32_t n)
+    : m_os (os), m_tleSet (tleSet), m_n (n) { }
+
+  /**
+   * Time an operation over all satellites and time instants.
+   *
+   * @param name   Name of the operation
+   * @param steps  Number of time instants
+   * @param op     Operation on satellite i at time instant k, returns a checksum
+   */
+  template <typename Op>
+  void
+  Run (const std::string &name, uint32_t steps, Op op)
+  {
+    double checksum = 0.0;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+    for (uint32_t k = 0; k < steps; k++)
+      {
+        for (uint32_t i = 0; i < m_n; i++)
+          checksum += op (i, k);
+      }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+    Write (name, (uint64_t) steps * m_n, std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count (), checksum);
+  }
+
+  /**
+   * Write a measurement.
+   *
+   * @param name      Name of the operation
+   * @param numOps    Number of operations
+   * @param totalNs   Total wall-clock time (ns)
+   * @param checksum  Checksum of the results (keeps the operation from being optimized away)
+   */
+  void
+  Write (const std::string &name, uint64_t numOps, int64_t totalNs, double checksum)
+  {
+    m_os << m_tleSet << "," << name << "," << m_n << "," << numOps << "," << totalNs << ","
+         << (double) totalNs / numOps << "," << checksum << std::endl;
+  }
+
+private:
+  std::ostream &m_os;       //!< output
+  std::string m_tleSet;     //!< TLE set name
+  uint32_t m_n;             //!< number of satellites
+};
+
+/**
+ * Time GetDistanceFrom between consecutive satellites within simulation
+ * events, one event per time instant.
+ *
+ * @param writer      Output
+ * @param name        Name of the operation
+ * @param satellites  Satellites
+ * @param steps       Number of time instants (1 s apart)
+ * @param cache       Position cache (can be 0)
+ */
+void
+RunGetDistanceFrom (BenchWriter &writer, const std::string &name,
+                    const std::vector<Ptr<Satellite> > &satellites, uint32_t steps,
+                    Ptr<SatellitePositionCache> cache)
+{
+  std::vector<Ptr<SatellitePositionMobilityModel> > models;
+  for (const Ptr<Satellite> &satellite : satellites)
+    {
+      Ptr<SatellitePositionMobilityModel> model = CreateObject<SatellitePositionMobilityModel> ();
+      model->SetSatellite (satellite);
+      model->SetStartTime (satellite->GetTleEpoch ());
+      model->SetPositionCache (cache);
+      models.push_back (model);
+    }
+
+  int64_t totalNs = 0;
+  double checksum = 0.0;
+  for (uint32_t k = 0; k < steps; k++)
+    {
+      Simulator::Schedule (Seconds (k), [&models, &totalNs, &checksum] () {
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+        for (uint32_t i = 0; i < models.size (); i++)
+          checksum += models[i]->GetDistanceFrom (models[(i + 1) % models.size ()]);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+        totalNs += std::chrono::duration_cast<std::chrono::nanoseconds> (end - begin).count ();
+      });
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  writer.Write (name, (uint64_t) steps * models.size (), totalNs, checksum);
+}
+
+/**
+ * Run all benchmarks on a TLE set.
+ *
+ * @param os        Output
+ * @param tleSet    Name of the TLE set
+ * @param filename  TLE set file ("" for the built-in TLEs)
+ * @param steps     Number of time instants (1 s apart)
+ */
+void
+RunTleSet (std::ostream &os, const std::string &tleSet, const std::string &filename, uint32_t steps)
+{
+  std::vector<Ptr<Satellite> > satellites = ReadTles (filename);
+  uint32_t n = satellites.size ();
+  BenchWriter writer (os, tleSet, n);
+
+  // Inputs, such that only the operation itself is timed
+  std::vector<elsetrec> records;
+  std::vector<JulianDate> epochs;
+  for (const Ptr<Satellite> &satellite : satellites)
+    {
+      records.push_back (satellite->GetSgp4Record ());
+      epochs.push_back (satellite->GetTleEpoch ());
+    }
+  std::vector<JulianDate> times;
+  std::vector<Time> offsets;
+  for (uint32_t k = 0; k < steps; k++)
+    {
+      offsets.push_back (Seconds (k));
+      times.push_back (epochs[0] + offsets.back ());
+    }
+  std::vector<Vector3D> rteme (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double r[3], v[3];
+      sgp4 (Satellite::WGeoSys, records[i], 0.0, r, v);
+      rteme[i] = Vector3D (r[0], r[1], r[2]);
+    }
+
+  writer.Run ("sgp4", steps, [&] (uint32_t i, uint32_t k) {
+    double r[3], v[3];
+    sgp4 (Satellite::WGeoSys, records[i], (times[k] - epochs[i]).GetMinutes (), r, v);
+    return r[0] + v[0];
+  });
+
+  writer.Run ("Satellite::GetPosition", steps, [&] (uint32_t i, uint32_t k) {
+    return satellites[i]->GetPosition (times[k]).x;
+  });
+
+  writer.Run ("Satellite::GetPosition+GetVelocity", steps, [&] (uint32_t i, uint32_t k) {
+    return satellites[i]->GetPosition (times[k]).x + satellites[i]->GetVelocity (times[k]).x;
+  });
+
+  writer.Run ("Satellite::GetState", steps, [&] (uint32_t i, uint32_t k) {
+    Satellite::State state = satellites[i]->GetState (times[k]);
+    return state.position.x + state.velocity.x;
+  });
+
+  writer.Run ("TemeToItrf (per call)", steps, [&] (uint32_t i, uint32_t k) {
+    return FrameTransform (times[k]).TransformPosition (rteme[i]).x;
+  });
+
+  writer.Run ("TemeToItrf (shared per time instant)", steps, [&] (uint32_t i, uint32_t k) {
+    return FrameTransform::TemeToItrf (times[k]).TransformPosition (rteme[i]).x;
+  });
+
+  writer.Run ("JulianDate+Time", steps, [&] (uint32_t i, uint32_t k) {
+    return (epochs[i] + offsets[k]).GetDouble ();
+  });
+
+  writer.Run ("JulianDate-JulianDate", steps, [&] (uint32_t i, uint32_t k) {
+    return (times[k] - epochs[i]).GetMinutes ();
+  });
+
+  RunGetDistanceFrom (writer, "SatellitePositionMobilityModel::GetDistanceFrom", satellites, steps, 0);
+
+  Ptr<SatellitePositionCache> cache = CreateObject<SatellitePositionCache> ();
+  RunGetDistanceFrom (writer, "SatellitePositionMobilityModel::GetDistanceFrom (cached)", satellites, steps, cache);
+}
+
+} // namespace
+
+int
+main (int argc, char *argv[])
+{
+  std::string tles = "";
+  std::string output = "";
+  uint32_t numSteps = 100;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("tles", "Comma-separated TLE sets (tles.txt format), empty for built-in TLEs", tles);
+  cmd.AddValue ("steps", "Number of time instants (1 s apart)", numSteps);
+  cmd.AddValue ("output", "CSV output file (empty for standard output)", output);
+  cmd.Parse (argc, argv);
+
+  std::ofstream ofs;
+  if (!output.empty ())
+    {
+      ofs.open (output.c_str ());
+      NS_ABORT_MSG_UNLESS (ofs.is_open (), "Output file " << output << " could not be opened");
+    }
+  std::ostream &os = output.empty () ? std::cout : ofs;
+  os << "tle_set,operation,num_satellites,num_ops,total_ns,ns_per_op,checksum" << std::endl;
+
+  if (tles.empty ())
+    RunTleSet (os, "builtin", "", numSteps);
+
+  std::istringstream ss (tles);
+  std::string filename;
+  while (std::getline (ss, filename, ','))
+    RunTleSet (os, filename, filename, numSteps);
+
+  return 0;
+}
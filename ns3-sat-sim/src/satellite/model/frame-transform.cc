@@ -0,0 +1,162 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "frame-transform.h"
+
+#include <cmath>
+#include <utility>
+
+namespace ns3 {
+
+FrameTransform::FrameTransform (const JulianDate &t)
+  : m_date (t)
+{
+  Init (0.0);
+}
+
+FrameTransform::FrameTransform (const JulianDate &start, int64_t offsetNs)
+{
+  // Split into whole milliseconds (JulianDate resolution) and the remainder
+  int64_t ms = offsetNs / 1000000;
+  int64_t residualNs = offsetNs % 1000000;
+  if (residualNs < 0)
+    {
+      ms--;
+      residualNs += 1000000;
+    }
+  m_date = (ms >= 0 ? start + MilliSeconds (ms) : start - MilliSeconds (-ms));
+  Init (residualNs * 1e-9);
+}
+
+void
+FrameTransform::Init (double residual)
+{
+  const JulianDate &t = m_date;
+  std::pair<double, double> eop = t.GetPolarMotion ();
+
+  const double &xp = eop.first, &yp = eop.second;
+  const double cosxp = cos (xp), cosyp = cos (yp);
+  const double sinxp = sin (xp), sinyp = sin (yp);
+
+  // [from AIAA-2006-6753 Report, Page 32, Appendix C - TEME Coordinate System]
+  //
+  // Matrix(ITRF<->PEF) = ROT1(yp)*ROT2(xp) [using c for cos, and s for sin]
+  //
+  // | 1    0     0   |*| c(xp) 0 -s(xp) |=|    c(xp)       0      -s(xp)   |
+  // | 0  c(yp) s(yp) | |   0   1    0   | | s(yp)*s(xp)  c(yp) s(yp)*c(xp) |
+  // | 0 -s(yp) c(yp) | | s(xp) 0  c(xp) | | c(yp)*s(xp) -s(yp) c(yp)*c(xp) |
+  //
+  // PEF->ITRF is the transpose of the above
+  m_pef[0][0] = cosxp;  m_pef[0][1] = sinyp*sinxp; m_pef[0][2] = cosyp*sinxp;
+  m_pef[1][0] = 0;      m_pef[1][1] = cosyp;       m_pef[1][2] = -sinyp;
+  m_pef[2][0] = -sinxp; m_pef[2][1] = sinyp*cosxp; m_pef[2][2] = cosyp*cosxp;
+
+  // rPEF = ROT3(gmst)*rTEME
+  //
+  // |  cos(gmst) sin(gmst) 0 |
+  // | -sin(gmst) cos(gmst) 0 |
+  // |      0         0     1 |
+  //
+  // The Earth rotates by omega * residual in the sub-millisecond remainder
+  m_omegaEarth = t.GetOmegaEarth ();
+  const double gmst = t.GetGmst () + m_omegaEarth*residual;
+  m_cosGmst = cos (gmst);
+  m_sinGmst = sin (gmst);
+
+  // Combined TEME->ITRF = PEF->ITRF * TEME->PEF
+  for (int i = 0; i < 3; i++)
+    {
+      m_teme[i][0] = m_pef[i][0]*m_cosGmst - m_pef[i][1]*m_sinGmst;
+      m_teme[i][1] = m_pef[i][0]*m_sinGmst + m_pef[i][1]*m_cosGmst;
+      m_teme[i][2] = m_pef[i][2];
+    }
+}
+
+const FrameTransform&
+FrameTransform::TemeToItrf (const JulianDate &t)
+{
+  static FrameTransform shared (t);
+
+  if (shared.m_date != t)
+    shared = FrameTransform (t);
+
+  return shared;
+}
+
+const FrameTransform&
+FrameTransform::TemeToItrf (const JulianDate &start, int64_t offsetNs)
+{
+  static FrameTransform shared (start, offsetNs);
+  static JulianDate sharedStart = start;
+  static int64_t sharedOffsetNs = offsetNs;
+
+  if (sharedOffsetNs != offsetNs || sharedStart != start)
+    {
+      shared = FrameTransform (start, offsetNs);
+      sharedStart = start;
+      sharedOffsetNs = offsetNs;
+    }
+
+  return shared;
+}
+
+const JulianDate&
+FrameTransform::GetDate (void) const
+{
+  return m_date;
+}
+
+double
+FrameTransform::GetOmegaEarth (void) const
+{
+  return m_omegaEarth;
+}
+
+Vector3D
+FrameTransform::TransformPosition (const Vector3D &rteme) const
+{
+  return Vector3D (
+    m_teme[0][0]*rteme.x + m_teme[0][1]*rteme.y + m_teme[0][2]*rteme.z,
+    m_teme[1][0]*rteme.x + m_teme[1][1]*rteme.y + m_teme[1][2]*rteme.z,
+    m_teme[2][0]*rteme.x + m_teme[2][1]*rteme.y + m_teme[2][2]*rteme.z
+  );
+}
+
+Vector3D
+FrameTransform::TransformVelocity (const Vector3D &rteme, const Vector3D &vteme) const
+{
+  // Position and velocity in PEF
+  const double rx = m_cosGmst*rteme.x + m_sinGmst*rteme.y;
+  const double ry = -m_sinGmst*rteme.x + m_cosGmst*rteme.y;
+  const double vx = m_cosGmst*vteme.x + m_sinGmst*vteme.y;
+  const double vy = -m_sinGmst*vteme.x + m_cosGmst*vteme.y;
+
+  // vPEF - w x rPEF, with w = (0, 0, omega)
+  const double x = vx + m_omegaEarth*ry;
+  const double y = vy - m_omegaEarth*rx;
+  const double z = vteme.z;
+
+  return Vector3D (
+    m_pef[0][0]*x + m_pef[0][1]*y + m_pef[0][2]*z,
+    m_pef[1][0]*x + m_pef[1][1]*y + m_pef[1][2]*z,
+    m_pef[2][0]*x + m_pef[2][1]*y + m_pef[2][2]*z
+  );
+}
+
+} // namespace ns3
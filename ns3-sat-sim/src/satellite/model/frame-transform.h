@@ -0,0 +1,129 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SATELLITE_FRAME_TRANSFORM_H
+#define SATELLITE_FRAME_TRANSFORM_H
+
+#include <stdint.h>
+
+#include "ns3/vector.h"
+
+#include "julian-date.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * @brief TEME to ITRF coordinate frame transform at a given time instant.
+ *
+ * The transform from the TEME frame (output of SGP4/SDP4) to the ITRF frame
+ * consists of a rotation by the Greenwich mean sidereal time (TEME->PEF)
+ * followed by the polar motion rotation (PEF->ITRF), see AIAA-2006-6753
+ * Report, Appendix C. Both only depend on time and not on the satellite, so
+ * the combined rotation matrix and the Earth's angular velocity are computed
+ * once per time instant and can be applied to any number of satellites.
+ *
+ * JulianDate has millisecond resolution. For a time instant given as an
+ * integer nanosecond offset from a start date, the sub-millisecond remainder
+ * is applied as an additional Earth rotation on top of the GMST of the
+ * millisecond-aligned date, such that positions are not quantized to 1 ms.
+ *
+ * TemeToItrf() returns a shared instance that is only recomputed when it is
+ * requested for a different time instant than the previous call. It is not
+ * thread-safe; threads should construct their own instances instead.
+ */
+class FrameTransform {
+public:
+  /**
+   * @brief Create the transform for a given time instant.
+   * @param t When.
+   */
+  explicit FrameTransform (const JulianDate &t);
+
+  /**
+   * @brief Create the transform for a time instant given as an offset from a
+   *        start date, with nanosecond resolution.
+   * @param start the start date.
+   * @param offsetNs the offset from the start date (ns).
+   */
+  FrameTransform (const JulianDate &start, int64_t offsetNs);
+
+  /**
+   * @brief Get the shared transform for a given time instant (recomputed
+   *        only if the time instant differs from the previous call).
+   * @param t When.
+   * @return the TEME to ITRF transform at time t.
+   */
+  static const FrameTransform& TemeToItrf (const JulianDate &t);
+
+  /**
+   * @brief Get the shared transform for a time instant given as an offset from
+   *        a start date (recomputed only if it differs from the previous call).
+   * @param start the start date.
+   * @param offsetNs the offset from the start date (ns).
+   * @return the TEME to ITRF transform at that time instant.
+   */
+  static const FrameTransform& TemeToItrf (const JulianDate &start, int64_t offsetNs);
+
+  /**
+   * @brief Get the time instant of this transform (millisecond-aligned, see
+   *        the constructor with a nanosecond offset).
+   * @return the time instant.
+   */
+  const JulianDate& GetDate (void) const;
+
+  /**
+   * @brief Get the Earth's angular velocity at this time instant.
+   * @return the Earth's angular velocity (rad/s).
+   */
+  double GetOmegaEarth (void) const;
+
+  /**
+   * @brief Convert a position vector from TEME to ITRF.
+   * @param rteme the position vector in TEME coordinates.
+   * @return the position vector in ITRF coordinates (same unit as rteme).
+   */
+  Vector3D TransformPosition (const Vector3D &rteme) const;
+
+  /**
+   * @brief Convert a velocity vector from TEME to ITRF.
+   * @param rteme the position vector in TEME coordinates.
+   * @param vteme the velocity vector in TEME coordinates.
+   * @return the velocity vector in ITRF coordinates (same unit as vteme,
+   *         with rteme in the unit of distance of vteme).
+   */
+  Vector3D TransformVelocity (const Vector3D &rteme, const Vector3D &vteme) const;
+
+private:
+  /**
+   * @brief Compute the rotations.
+   * @param residual the time after m_date to rotate the Earth further (s).
+   */
+  void Init (double residual);
+
+  JulianDate m_date;            //!< time instant of the transform.
+  double m_cosGmst, m_sinGmst;  //!< TEME->PEF rotation (by GMST).
+  double m_pef[3][3];           //!< PEF->ITRF rotation (polar motion).
+  double m_teme[3][3];          //!< combined TEME->ITRF rotation.
+  double m_omegaEarth;          //!< Earth's angular velocity (rad/s).
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_FRAME_TRANSFORM_H */
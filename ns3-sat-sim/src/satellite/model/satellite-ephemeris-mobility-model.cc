@@ -0,0 +1,207 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "satellite-ephemeris-mobility-model.h"
+
+#include <vector>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SatelliteEphemerisMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED (SatelliteEphemerisMobilityModel);
+
+TypeId
+SatelliteEphemerisMobilityModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatelliteEphemerisMobilityModel")
+    .SetParent<MobilityModel> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<SatelliteEphemerisMobilityModel> ()
+    .AddAttribute ("SatellitePositionHelper",
+                   "The satellite position helper that holds the satellite reference of this node",
+                   SatellitePositionHelperValue (SatellitePositionHelper ()),
+                   MakeSatellitePositionHelperAccessor (&SatelliteEphemerisMobilityModel::m_helper),
+                   MakeSatellitePositionHelperChecker ())
+    .AddAttribute ("SampleInterval",
+                   "Interval between two ephemeris samples (interpolation grid)",
+                   TimeValue (Seconds (10)),
+                   MakeTimeAccessor (&SatelliteEphemerisMobilityModel::SetSampleInterval,
+                                     &SatelliteEphemerisMobilityModel::GetSampleInterval),
+                   MakeTimeChecker ())
+  ;
+
+  return tid;
+}
+
+SatelliteEphemerisMobilityModel::SatelliteEphemerisMobilityModel (void)
+  : m_interval (Seconds (10)), m_ephemerisIndex (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatelliteEphemerisMobilityModel::~SatelliteEphemerisMobilityModel (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Ptr<Satellite>
+SatelliteEphemerisMobilityModel::GetSatellite (void) const
+{
+  return m_helper.GetSatellite ();
+}
+
+JulianDate
+SatelliteEphemerisMobilityModel::GetStartTime (void) const
+{
+  return m_helper.GetStartTime ();
+}
+
+void
+SatelliteEphemerisMobilityModel::SetSatellite (Ptr<Satellite> sat)
+{
+  m_helper.SetSatellite (sat);
+  Invalidate ();
+}
+
+void
+SatelliteEphemerisMobilityModel::SetStartTime (const JulianDate &t)
+{
+  m_helper.SetStartTime (t);
+  Invalidate ();
+}
+
+Time
+SatelliteEphemerisMobilityModel::GetSampleInterval (void) const
+{
+  return m_interval;
+}
+
+void
+SatelliteEphemerisMobilityModel::SetSampleInterval (const Time &interval)
+{
+  NS_ABORT_MSG_IF (interval < MilliSeconds (1),
+                   "The ephemeris sample interval must be at least 1 ms.");
+  m_interval = interval;
+  Invalidate ();
+}
+
+void
+SatelliteEphemerisMobilityModel::Build (const Time &duration)
+{
+  NS_LOG_FUNCTION (this << duration);
+  NS_ABORT_MSG_UNLESS (m_helper.GetSatellite (), "Satellite must be set before building the ephemeris.");
+
+  m_ephemeris = SatelliteEphemeris::Build (std::vector<Ptr<Satellite> > (1, m_helper.GetSatellite ()),
+                                           std::vector<JulianDate> (1, m_helper.GetStartTime ()),
+                                           duration, m_interval, 1);
+  m_ephemerisIndex = 0;
+}
+
+void
+SatelliteEphemerisMobilityModel::SetEphemeris (Ptr<SatelliteEphemeris> ephemeris, uint32_t index)
+{
+  NS_LOG_FUNCTION (this << ephemeris << index);
+  NS_ABORT_MSG_UNLESS (ephemeris && index < ephemeris->GetNSatellites (), "Invalid ephemeris index.");
+  m_ephemeris = ephemeris;
+  m_ephemerisIndex = index;
+}
+
+Ptr<SatelliteEphemeris>
+SatelliteEphemerisMobilityModel::GetEphemeris (void) const
+{
+  return m_ephemeris;
+}
+
+bool
+SatelliteEphemerisMobilityModel::IsBuilt (void) const
+{
+  return m_ephemeris != 0;
+}
+
+double
+SatelliteEphemerisMobilityModel::GetErrorBound (void) const
+{
+  return m_ephemeris ? m_ephemeris->GetErrorBound (m_ephemerisIndex) : 0.0;
+}
+
+Vector3D
+SatelliteEphemerisMobilityModel::GetPositionAt (const Time &t) const
+{
+  Vector3D position;
+  if (m_ephemeris && m_ephemeris->Interpolate (m_ephemerisIndex, t, &position, 0))
+    return position;
+
+  if (m_helper.GetSatellite () && m_helper.GetSatellite ()->IsInitialized ())
+    return m_helper.GetPosition (t);
+
+  // No orbit to propagate, hold the position at the edge of the sampled range
+  NS_ABORT_MSG_UNLESS (m_ephemeris && m_ephemeris->GetNSamples () >= 2,
+                       "Satellite has neither an ephemeris nor an orbit to propagate.");
+  Time last = m_ephemeris->GetInterval () * (int64_t) (m_ephemeris->GetNSamples () - 1);
+  m_ephemeris->Interpolate (m_ephemerisIndex, t.IsNegative () ? Time (0) : last, &position, 0);
+  return position;
+}
+
+void
+SatelliteEphemerisMobilityModel::Invalidate (void)
+{
+  m_ephemeris = 0;
+  m_ephemerisIndex = 0;
+}
+
+Vector3D
+SatelliteEphemerisMobilityModel::DoGetPosition (void) const
+{
+  Vector3D position;
+  if (!m_ephemeris || !m_ephemeris->Interpolate (m_ephemerisIndex, Simulator::Now (), &position, 0))
+    {
+      NS_ABORT_MSG_UNLESS (m_helper.GetSatellite () && m_helper.GetSatellite ()->IsInitialized (),
+                           "Time " << Simulator::Now () << " is outside of the ephemeris, and the satellite has no orbit to propagate.");
+      return m_helper.GetPosition ();
+    }
+
+  return position;
+}
+
+void
+SatelliteEphemerisMobilityModel::DoSetPosition (const Vector3D &position)
+{
+  // position is not settable
+}
+
+Vector3D
+SatelliteEphemerisMobilityModel::DoGetVelocity (void) const
+{
+  Vector3D velocity;
+  if (!m_ephemeris || !m_ephemeris->Interpolate (m_ephemerisIndex, Simulator::Now (), 0, &velocity))
+    {
+      NS_ABORT_MSG_UNLESS (m_helper.GetSatellite () && m_helper.GetSatellite ()->IsInitialized (),
+                           "Time " << Simulator::Now () << " is outside of the ephemeris, and the satellite has no orbit to propagate.");
+      return m_helper.GetVelocity ();
+    }
+
+  return velocity;
+}
+
+} // namespace ns3
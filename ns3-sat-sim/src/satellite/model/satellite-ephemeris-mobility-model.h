@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SATELLITE_EPHEMERIS_MOBILITY_MODEL_H
+#define SATELLITE_EPHEMERIS_MOBILITY_MODEL_H
+
+#include <stdint.h>
+#include <string>
+
+#include "ns3/julian-date.h"
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/satellite.h"
+#include "ns3/type-id.h"
+
+#include "satellite-ephemeris.h"
+#include "satellite-position-helper.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup mobility
+ * @brief Satellite mobility model based on a precomputed ephemeris.
+ *
+ * When built, this mobility model samples the position and velocity of the
+ * underlying Satellite object (SGP4/SDP4) on a regular grid that covers the
+ * simulation. Afterwards, position and velocity queries are answered by cubic
+ * Hermite interpolation between the two surrounding samples, which only costs
+ * a few multiply-adds instead of a full SGP4 propagation and frame transform.
+ *
+ * The interpolation error grows with the sample interval. While building, the
+ * model compares the interpolated position against exact SGP4 at the midpoint
+ * of every grid interval (where the Hermite error is largest) and keeps the
+ * maximum deviation as error bound, such that the accuracy can be traded for
+ * speed per experiment. Queries outside of the sampled time range fall back to
+ * exact SGP4 propagation (if the satellite has TLE information, i.e., not when
+ * the ephemeris was loaded from a file without initializing the satellite).
+ *
+ * The samples are kept in a SatelliteEphemeris, which can either be built for
+ * this satellite alone (Build), or be shared by all satellites of a
+ * constellation and built in parallel once before the simulation (SetEphemeris).
+ *
+ * As with SatellitePositionMobilityModel, DoSetPosition has no effect.
+ */
+class SatelliteEphemerisMobilityModel : public MobilityModel {
+public:
+  /**
+   * @brief Get the type ID.
+   * @return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * @brief Default constructor.
+   */
+  SatelliteEphemerisMobilityModel (void);
+
+  /**
+   * @brief Destructor.
+   */
+  virtual ~SatelliteEphemerisMobilityModel (void);
+
+  /**
+   * @brief Get the underlying Satellite object.
+   * @return a pointer to the underlying Satellite object.
+   */
+  Ptr<Satellite> GetSatellite (void) const;
+
+  /**
+   * @brief Get the time instant considered as the simulation start.
+   * @return a JulianDate object with the time considered as simulation start.
+   */
+  JulianDate GetStartTime (void) const;
+
+  /**
+   * @brief Set the underlying Satellite object (invalidates the ephemeris).
+   * @param sat a pointer to the Satellite object to be used.
+   */
+  void SetSatellite (Ptr<Satellite> sat);
+
+  /**
+   * @brief Set the time instant considered as the simulation start
+   *        (invalidates the ephemeris).
+   * @param t the time instant to be considered as simulation start.
+   */
+  void SetStartTime (const JulianDate &t);
+
+  /**
+   * @brief Get the interval between two ephemeris samples.
+   * @return the sample interval.
+   */
+  Time GetSampleInterval (void) const;
+
+  /**
+   * @brief Set the interval between two ephemeris samples (invalidates the
+   *        ephemeris).
+   * @param interval the sample interval (at least 1 ms).
+   */
+  void SetSampleInterval (const Time &interval);
+
+  /**
+   * @brief Sample the satellite over [0, duration] of simulation time.
+   * @param duration the simulation time span the ephemeris must cover.
+   */
+  void Build (const Time &duration);
+
+  /**
+   * @brief Use the samples of a (shared) ephemeris, which must have been built
+   *        for the satellite and start time of this model.
+   * @param ephemeris the ephemeris.
+   * @param index the index of the satellite in the ephemeris.
+   */
+  void SetEphemeris (Ptr<SatelliteEphemeris> ephemeris, uint32_t index);
+
+  /**
+   * @brief Get the ephemeris in use.
+   * @return the ephemeris, or null if not built.
+   */
+  Ptr<SatelliteEphemeris> GetEphemeris (void) const;
+
+  /**
+   * @brief Check whether the ephemeris has been built.
+   * @return true if Build() has been called since the last invalidation.
+   */
+  bool IsBuilt (void) const;
+
+  /**
+   * @brief Get the maximum interpolated position deviation from exact SGP4,
+   *        as measured at the midpoint of each interval while building.
+   * @return the error bound in meters.
+   */
+  double GetErrorBound (void) const;
+
+  /**
+   * @brief Get the position at an arbitrary simulation time. Outside of the
+   *        sampled range the satellite is propagated exactly, or, if it has
+   *        no orbit (ephemeris loaded from a file), the position at the edge
+   *        of the sampled range is returned.
+   * @param t simulation time.
+   * @return the position (m).
+   */
+  Vector3D GetPositionAt (const Time &t) const;
+
+private:
+  virtual Vector DoGetPosition (void) const;
+  virtual void DoSetPosition (const Vector &position);
+  virtual Vector DoGetVelocity (void) const;
+
+  /**
+   * @brief Discard the samples (e.g., after a parameter change).
+   */
+  void Invalidate (void);
+
+  SatellitePositionHelper m_helper;     //!< helper for orbital computations
+  Time m_interval;                      //!< interval between samples used by Build
+  Ptr<SatelliteEphemeris> m_ephemeris;  //!< samples (null if not built)
+  uint32_t m_ephemerisIndex;            //!< index of the satellite in m_ephemeris
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_EPHEMERIS_MOBILITY_MODEL_H */
@@ -0,0 +1,510 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "satellite-ephemeris.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include "frame-transform.h"
+#include "sgp4-batch-propagator.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SatelliteEphemeris");
+
+NS_OBJECT_ENSURE_REGISTERED (SatelliteEphemeris);
+
+const uint32_t SatelliteEphemeris::ValuesPerSample = 6;
+
+namespace {
+
+/// Magic bytes at the start of an ephemeris file
+const char EphemerisFileMagic[8] = {'S', 'A', 'T', 'E', 'P', 'H', 'E', 'M'};
+
+/// Current version of the ephemeris file format
+const uint32_t EphemerisFileVersion = 2;
+
+/// Fixed header of an ephemeris file (see SatelliteEphemeris)
+struct EphemerisFileHeader {
+  char magic[8];                //!< EphemerisFileMagic
+  uint32_t version;             //!< EphemerisFileVersion
+  uint32_t valuesPerSample;     //!< SatelliteEphemeris::ValuesPerSample
+  uint32_t nSatellites;         //!< number of satellites
+  uint32_t nSamples;            //!< number of samples per satellite
+  int64_t intervalNs;           //!< interval between samples (ns)
+};
+
+/**
+ * Check the byte order of this machine; the file is written and mapped as-is,
+ * so it is only supported on little-endian machines.
+ *
+ * @return true if little-endian
+ */
+bool
+IsLittleEndian (void)
+{
+  const uint16_t one = 1;
+  return *reinterpret_cast<const uint8_t *> (&one) == 1;
+}
+
+/// Satellites that share the same simulation start and TLE epoch, such that
+/// they can be propagated as one batch and share the frame transform
+struct EphemerisGroup {
+  JulianDate start;                     //!< absolute simulation start
+  JulianDate epoch;                     //!< TLE epoch
+  int64_t epochOffsetNs;                //!< start - epoch (ns)
+  std::vector<uint32_t> indices;        //!< satellite indices
+  Sgp4BatchPropagator batch;            //!< propagator of the satellites
+  std::vector<double> r, v;             //!< TEME output buffers (km, km/s)
+  std::vector<int> error;               //!< SGP4 error output buffer
+};
+
+/**
+ * Sample all satellites at simulation time tNs.
+ *
+ * @param groups  Satellite groups
+ * @param tNs     Simulation time (ns)
+ * @param out     Output, ValuesPerSample values per satellite index
+ */
+void
+SampleAll (std::vector<EphemerisGroup> &groups, int64_t tNs, double *out)
+{
+  const uint32_t n = SatelliteEphemeris::ValuesPerSample;
+  for (EphemerisGroup &group : groups)
+    {
+      FrameTransform frame (group.start, tNs);
+      group.batch.Propagate ((group.epochOffsetNs + tNs) / 6e10,
+                             group.r.data (), group.v.data (), group.error.data ());
+
+      for (uint32_t j = 0; j < group.indices.size (); j++)
+        {
+          double *o = out + n * group.indices[j];
+          if (group.error[j] != 0)
+            {
+              std::fill (o, o + n, 0.0);
+              continue;
+            }
+
+          // km -> m and km/s -> m/s
+          Vector3D rteme (group.r[3*j], group.r[3*j + 1], group.r[3*j + 2]);
+          Vector3D vteme (group.v[3*j], group.v[3*j + 1], group.v[3*j + 2]);
+          Vector3D r = frame.TransformPosition (rteme);
+          Vector3D v = frame.TransformVelocity (rteme, vteme);
+          o[0] = r.x*1000;
+          o[1] = r.y*1000;
+          o[2] = r.z*1000;
+          o[3] = 1000*v.x;
+          o[4] = 1000*v.y;
+          o[5] = 1000*v.z;
+        }
+    }
+}
+
+/**
+ * Fill the samples [first, last) of all satellites (and the final sample if
+ * last is the final interval), and measure the error at the midpoints.
+ *
+ * @param groups        Satellite groups (a copy owned by this thread)
+ * @param nSatellites   Number of satellites
+ * @param nSamples      Number of samples per satellite
+ * @param intervalNs    Interval between samples (ns)
+ * @param first         First interval
+ * @param last          One past the last interval
+ * @param samples       Output samples
+ * @param errorBounds   Output error bound per satellite (m)
+ */
+void
+BuildRange (std::vector<EphemerisGroup> groups, uint32_t nSatellites, uint32_t nSamples,
+            int64_t intervalNs, uint32_t first, uint32_t last,
+            double *samples, double *errorBounds)
+{
+  const uint32_t n = SatelliteEphemeris::ValuesPerSample;
+  const double dt = intervalNs / 1e9;
+  const double sMid = (intervalNs / 2) / (double) intervalNs;
+  std::vector<double> cur (n * nSatellites), next (n * nSatellites), mid (n * nSatellites);
+
+  SampleAll (groups, first * intervalNs, cur.data ());
+  for (uint32_t k = first; k < last; k++)
+    {
+      for (uint32_t i = 0; i < nSatellites; i++)
+        std::copy (&cur[n * i], &cur[n * i] + n, samples + n * ((uint64_t) i * nSamples + k));
+
+      SampleAll (groups, (k + 1) * intervalNs, next.data ());
+      SampleAll (groups, k * intervalNs + intervalNs / 2, mid.data ());
+      for (uint32_t i = 0; i < nSatellites; i++)
+        {
+          Vector3D interpolated;
+          SatelliteEphemeris::Hermite (&cur[n * i], &next[n * i], dt, sMid, &interpolated, 0);
+          Vector3D exact (mid[n * i], mid[n * i + 1], mid[n * i + 2]);
+          errorBounds[i] = std::max (errorBounds[i], CalculateDistance (interpolated, exact));
+        }
+
+      std::swap (cur, next);
+    }
+
+  if (last == nSamples - 1)
+    {
+      for (uint32_t i = 0; i < nSatellites; i++)
+        std::copy (&cur[n * i], &cur[n * i] + n, samples + n * ((uint64_t) i * nSamples + last));
+    }
+}
+
+} // namespace
+
+TypeId
+SatelliteEphemeris::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatelliteEphemeris")
+    .SetParent<Object> ()
+    .SetGroupName ("Satellite")
+    .AddConstructor<SatelliteEphemeris> ()
+  ;
+
+  return tid;
+}
+
+SatelliteEphemeris::SatelliteEphemeris (void)
+  : m_nSatellites (0), m_nSamples (0), m_intervalNs (1),
+    m_data (0), m_mapping (0), m_mappingSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatelliteEphemeris::~SatelliteEphemeris (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_mapping)
+    munmap (m_mapping, m_mappingSize);
+}
+
+Ptr<SatelliteEphemeris>
+SatelliteEphemeris::Build (
+  const std::vector<Ptr<Satellite> > &satellites,
+  const std::vector<JulianDate> &starts,
+  const Time &duration, const Time &interval, uint32_t numThreads
+)
+{
+  NS_ABORT_MSG_UNLESS (satellites.size () == starts.size (), "There must be one start time per satellite.");
+  NS_ABORT_MSG_IF (interval < MilliSeconds (1), "The ephemeris sample interval must be at least 1 ms.");
+  NS_ABORT_MSG_IF (duration.IsNegative (), "Ephemeris duration cannot be negative.");
+
+  Ptr<SatelliteEphemeris> ephemeris = CreateObject<SatelliteEphemeris> ();
+  ephemeris->m_intervalNs = interval.GetNanoSeconds ();
+
+  // Grid points cover [0, duration], the last one is at or beyond duration
+  int64_t numIntervals = std::max ((int64_t) 1, (duration.GetNanoSeconds () + ephemeris->m_intervalNs - 1) / ephemeris->m_intervalNs);
+  NS_ABORT_MSG_IF (numIntervals >= UINT32_MAX, "Too many ephemeris samples, increase the sample interval.");
+  ephemeris->m_nSatellites = satellites.size ();
+  ephemeris->m_nSamples = numIntervals + 1;
+  ephemeris->m_samples.resize ((uint64_t) ValuesPerSample * ephemeris->m_nSatellites * ephemeris->m_nSamples);
+  ephemeris->m_errorBounds.resize (ephemeris->m_nSatellites, 0.0);
+  for (uint32_t i = 0; i < satellites.size (); i++)
+    {
+      std::pair<std::string, std::string> tle = satellites[i]->GetTleInfo ();
+      ephemeris->m_tleEpochs.push_back (ParseTleEpoch (tle.first));
+      ephemeris->m_tleHashes.push_back (HashTle (tle.first, tle.second));
+    }
+
+  // Satellites with the same start and epoch are propagated together
+  std::map<std::pair<JulianDate, JulianDate>, uint32_t> groupIndex;
+  std::vector<EphemerisGroup> groups;
+  for (uint32_t i = 0; i < satellites.size (); i++)
+    {
+      NS_ABORT_MSG_UNLESS (satellites[i]->IsInitialized (), "Satellite " << i << " is not initialized.");
+      std::pair<JulianDate, JulianDate> key = std::make_pair (starts[i], satellites[i]->GetTleEpoch ());
+      std::map<std::pair<JulianDate, JulianDate>, uint32_t>::iterator it = groupIndex.find (key);
+      if (it == groupIndex.end ())
+        {
+          it = groupIndex.insert (std::make_pair (key, (uint32_t) groups.size ())).first;
+          groups.push_back (EphemerisGroup ());
+          groups.back ().start = key.first;
+          groups.back ().epoch = key.second;
+          groups.back ().epochOffsetNs = (key.first - key.second).GetNanoSeconds ();
+          groups.back ().batch = Sgp4BatchPropagator (Satellite::WGeoSys);
+        }
+      EphemerisGroup &group = groups[it->second];
+      group.indices.push_back (i);
+      group.batch.Add (satellites[i]->GetSgp4Record ());
+    }
+  for (EphemerisGroup &group : groups)
+    {
+      group.r.resize (3 * group.indices.size ());
+      group.v.resize (3 * group.indices.size ());
+      group.error.resize (group.indices.size ());
+    }
+
+  // Each thread handles a contiguous range of intervals
+  if (numThreads == 0)
+    numThreads = std::max (1u, std::thread::hardware_concurrency ());
+  numThreads = std::min ((int64_t) numThreads, numIntervals);
+  std::vector<std::vector<double> > threadErrorBounds (numThreads, std::vector<double> (ephemeris->m_nSatellites, 0.0));
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < numThreads; t++)
+    {
+      uint32_t first = numIntervals * t / numThreads;
+      uint32_t last = numIntervals * (t + 1) / numThreads;
+      threads.push_back (std::thread (BuildRange, groups, ephemeris->m_nSatellites, ephemeris->m_nSamples,
+                                      ephemeris->m_intervalNs, first, last,
+                                      ephemeris->m_samples.data (), threadErrorBounds[t].data ()));
+    }
+  for (std::thread &thread : threads)
+    thread.join ();
+
+  for (uint32_t t = 0; t < numThreads; t++)
+    {
+      for (uint32_t i = 0; i < ephemeris->m_nSatellites; i++)
+        ephemeris->m_errorBounds[i] = std::max (ephemeris->m_errorBounds[i], threadErrorBounds[t][i]);
+    }
+  ephemeris->m_data = ephemeris->m_samples.data ();
+
+  return ephemeris;
+}
+
+void
+SatelliteEphemeris::Save (const std::string &filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  NS_ABORT_MSG_UNLESS (IsLittleEndian (), "Ephemeris files are only supported on little-endian machines.");
+
+  EphemerisFileHeader header;
+  std::memcpy (header.magic, EphemerisFileMagic, sizeof (header.magic));
+  header.version = EphemerisFileVersion;
+  header.valuesPerSample = ValuesPerSample;
+  header.nSatellites = m_nSatellites;
+  header.nSamples = m_nSamples;
+  header.intervalNs = m_intervalNs;
+
+  std::ofstream ofs (filename.c_str (), std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_UNLESS (ofs.is_open (), "Ephemeris file " << filename << " could not be opened for writing");
+  ofs.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  ofs.write (reinterpret_cast<const char *> (m_errorBounds.data ()), sizeof (double) * m_nSatellites);
+  ofs.write (reinterpret_cast<const char *> (m_tleEpochs.data ()), sizeof (double) * m_nSatellites);
+  ofs.write (reinterpret_cast<const char *> (m_tleHashes.data ()), sizeof (uint64_t) * m_nSatellites);
+  ofs.write (reinterpret_cast<const char *> (m_data),
+             sizeof (double) * ValuesPerSample * (uint64_t) m_nSatellites * m_nSamples);
+  ofs.close ();
+  NS_ABORT_MSG_IF (ofs.fail (), "Ephemeris file " << filename << " could not be written");
+}
+
+Ptr<SatelliteEphemeris>
+SatelliteEphemeris::Load (const std::string &filename)
+{
+  NS_LOG_FUNCTION (filename);
+  NS_ABORT_MSG_UNLESS (IsLittleEndian (), "Ephemeris files are only supported on little-endian machines.");
+
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error ("Ephemeris file " + filename + " could not be opened");
+  struct stat st;
+  if (fstat (fd, &st) != 0)
+    {
+      close (fd);
+      throw std::runtime_error ("Ephemeris file " + filename + " could not be read");
+    }
+  size_t size = st.st_size;
+  if (size < sizeof (EphemerisFileHeader))
+    {
+      close (fd);
+      throw std::runtime_error ("Ephemeris file " + filename + " is truncated");
+    }
+  void *mapping = mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (mapping == MAP_FAILED)
+    throw std::runtime_error ("Ephemeris file " + filename + " could not be mapped");
+
+  // Owns the mapping from here on, such that it is unmapped if the file is rejected
+  Ptr<SatelliteEphemeris> ephemeris = CreateObject<SatelliteEphemeris> ();
+  ephemeris->m_mapping = mapping;
+  ephemeris->m_mappingSize = size;
+
+  // The header is at the start of the (page-aligned) mapping
+  const EphemerisFileHeader *header = static_cast<const EphemerisFileHeader *> (mapping);
+  if (std::memcmp (header->magic, EphemerisFileMagic, sizeof (header->magic)) != 0)
+    throw std::runtime_error ("File " + filename + " is not an ephemeris file");
+  if (header->version != EphemerisFileVersion)
+    throw std::runtime_error ("Ephemeris file " + filename + " has unsupported version " + std::to_string (header->version));
+  if (header->valuesPerSample != ValuesPerSample || header->nSamples < 2 || header->intervalNs <= 0)
+    throw std::runtime_error ("Ephemeris file " + filename + " has an invalid header");
+  uint64_t nSamplesTotal = (uint64_t) header->nSatellites * header->nSamples;
+  if (size != sizeof (EphemerisFileHeader) + sizeof (double) * (3 * (uint64_t) header->nSatellites + ValuesPerSample * nSamplesTotal))
+    throw std::runtime_error ("Ephemeris file " + filename + " does not match the size in its header");
+
+  ephemeris->m_nSatellites = header->nSatellites;
+  ephemeris->m_nSamples = header->nSamples;
+  ephemeris->m_intervalNs = header->intervalNs;
+  const double *errorBounds = reinterpret_cast<const double *> (header + 1);
+  ephemeris->m_errorBounds.assign (errorBounds, errorBounds + header->nSatellites);
+  const double *tleEpochs = errorBounds + header->nSatellites;
+  ephemeris->m_tleEpochs.assign (tleEpochs, tleEpochs + header->nSatellites);
+  const uint64_t *tleHashes = reinterpret_cast<const uint64_t *> (tleEpochs + header->nSatellites);
+  ephemeris->m_tleHashes.assign (tleHashes, tleHashes + header->nSatellites);
+  ephemeris->m_data = reinterpret_cast<const double *> (tleHashes + header->nSatellites);
+
+  return ephemeris;
+}
+
+double
+SatelliteEphemeris::ParseTleEpoch (const std::string &line1)
+{
+  // Columns 19-32 of the first line
+  NS_ABORT_MSG_IF (line1.size () < 32, "TLE line 1 is too short to hold an epoch: " << line1);
+  return std::stod (line1.substr (18, 14));
+}
+
+uint64_t
+SatelliteEphemeris::HashTle (const std::string &line1, const std::string &line2)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  std::string lines = line1 + "\n" + line2;
+  for (char c : lines)
+    {
+      hash ^= (uint8_t) c;
+      hash *= 1099511628211ULL;
+    }
+  return hash;
+}
+
+bool
+SatelliteEphemeris::IsMapped (void) const
+{
+  return m_mapping != 0;
+}
+
+uint32_t
+SatelliteEphemeris::GetNSatellites (void) const
+{
+  return m_nSatellites;
+}
+
+uint32_t
+SatelliteEphemeris::GetNSamples (void) const
+{
+  return m_nSamples;
+}
+
+Time
+SatelliteEphemeris::GetInterval (void) const
+{
+  return NanoSeconds (m_intervalNs);
+}
+
+double
+SatelliteEphemeris::GetErrorBound (uint32_t index) const
+{
+  NS_ASSERT (index < m_nSatellites);
+  return m_errorBounds[index];
+}
+
+double
+SatelliteEphemeris::GetMaxErrorBound (void) const
+{
+  double maxErrorBound = 0.0;
+  for (double errorBound : m_errorBounds)
+    maxErrorBound = std::max (maxErrorBound, errorBound);
+
+  return maxErrorBound;
+}
+
+double
+SatelliteEphemeris::GetTleEpoch (uint32_t index) const
+{
+  NS_ASSERT (index < m_nSatellites);
+  return m_tleEpochs[index];
+}
+
+uint64_t
+SatelliteEphemeris::GetTleHash (uint32_t index) const
+{
+  NS_ASSERT (index < m_nSatellites);
+  return m_tleHashes[index];
+}
+
+bool
+SatelliteEphemeris::Interpolate (uint32_t index, const Time &t, Vector3D *position, Vector3D *velocity) const
+{
+  NS_ASSERT (index < m_nSatellites);
+
+  int64_t tNs = t.GetNanoSeconds ();
+  if (m_nSamples < 2 || tNs < 0)
+    return false;
+
+  int64_t last = (int64_t) m_nSamples - 1;
+  int64_t k = tNs / m_intervalNs;
+  if (k >= last)
+    {
+      if (k > last || tNs > last * m_intervalNs)
+        return false;
+      k = last - 1;   // exactly on the last grid point
+    }
+
+  const double *a = m_data + ValuesPerSample * ((uint64_t) index * m_nSamples + k);
+  Hermite (a, a + ValuesPerSample, m_intervalNs / 1e9,
+           (tNs - k * m_intervalNs) / (double) m_intervalNs, position, velocity);
+
+  return true;
+}
+
+void
+SatelliteEphemeris::Hermite (const double *a, const double *b, double dt, double s,
+                             Vector3D *position, Vector3D *velocity)
+{
+  double s2 = s * s;
+  double s3 = s2 * s;
+
+  if (position)
+    {
+      // Cubic Hermite basis functions
+      double h00 = 2 * s3 - 3 * s2 + 1;
+      double h10 = (s3 - 2 * s2 + s) * dt;
+      double h01 = -2 * s3 + 3 * s2;
+      double h11 = (s3 - s2) * dt;
+      position->x = h00 * a[0] + h10 * a[3] + h01 * b[0] + h11 * b[3];
+      position->y = h00 * a[1] + h10 * a[4] + h01 * b[1] + h11 * b[4];
+      position->z = h00 * a[2] + h10 * a[5] + h01 * b[2] + h11 * b[5];
+    }
+
+  if (velocity)
+    {
+      // Time derivatives of the basis functions
+      double d00 = (6 * s2 - 6 * s) / dt;
+      double d10 = 3 * s2 - 4 * s + 1;
+      double d01 = (-6 * s2 + 6 * s) / dt;
+      double d11 = 3 * s2 - 2 * s;
+      velocity->x = d00 * a[0] + d10 * a[3] + d01 * b[0] + d11 * b[3];
+      velocity->y = d00 * a[1] + d10 * a[4] + d01 * b[1] + d11 * b[4];
+      velocity->z = d00 * a[2] + d10 * a[5] + d01 * b[2] + d11 * b[5];
+    }
+}
+
+} // namespace ns3
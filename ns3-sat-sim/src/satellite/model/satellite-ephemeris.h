@@ -0,0 +1,231 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SATELLITE_EPHEMERIS_H
+#define SATELLITE_EPHEMERIS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/type-id.h"
+#include "ns3/vector.h"
+
+#include "julian-date.h"
+#include "satellite.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * @brief Precomputed positions and velocities of a set of satellites.
+ *
+ * The ephemeris holds, for every satellite, its ITRF position (m) and velocity
+ * (m/s) on a regular grid of simulation times t = k * interval, k = 0..K, in
+ * one contiguous array (all samples of a satellite are adjacent). Positions in
+ * between grid points are obtained by cubic Hermite interpolation.
+ *
+ * Build() fills the array in parallel: the grid is split into contiguous
+ * ranges, one per thread, and every thread propagates all satellites over its
+ * range with its own copy of the SGP4 records (Sgp4BatchPropagator), and with
+ * one TEME->ITRF transform per grid point. The samples are identical to those
+ * of SatellitePositionHelper::GetPosition and GetVelocity. While building, the
+ * interpolated position is also compared against exact SGP4 at the midpoint of
+ * every interval, where the interpolation error is largest, and the maximum
+ * deviation of each satellite is kept as its error bound.
+ *
+ * An ephemeris can be saved to a binary file and loaded again in later runs,
+ * such that the same constellation need not be propagated again. The file is
+ * memory-mapped read-only, so concurrent runs share its pages through the OS
+ * page cache. To detect a file of another constellation, it records for every
+ * satellite the TLE epoch (as in the TLE, YYDDD.DDDDDDDD) and a 64-bit FNV-1a
+ * hash of the two TLE lines. File format (all values little-endian):
+ *
+ *   offset   size         content
+ *   0        8            magic "SATEPHEM"
+ *   8        4            format version (uint32, currently 2)
+ *   12       4            values per sample (uint32, 6)
+ *   16       4            number of satellites N (uint32)
+ *   20       4            number of samples per satellite K (uint32)
+ *   24       8            sample interval in ns (int64)
+ *   32       8*N          error bound of each satellite in m (double)
+ *   32+8*N   8*N          TLE epoch of each satellite (double)
+ *   32+16*N  8*N          TLE hash of each satellite (uint64)
+ *   32+24*N  8*6*K*N      samples (double), [satellite][sample][value]
+ */
+class SatelliteEphemeris : public Object {
+public:
+  /// Number of values per sample: position (x, y, z) and velocity (x, y, z).
+  static const uint32_t ValuesPerSample;
+
+  /**
+   * @brief Get the type ID.
+   * @return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * @brief Default constructor (empty ephemeris).
+   */
+  SatelliteEphemeris (void);
+
+  /**
+   * @brief Destructor.
+   */
+  virtual ~SatelliteEphemeris (void);
+
+  /**
+   * @brief Build the ephemeris of a set of satellites.
+   * @param satellites the (initialized) satellites.
+   * @param starts the absolute time of simulation start of each satellite.
+   * @param duration the simulation time span the ephemeris must cover.
+   * @param interval the interval between two samples (at least 1 ms).
+   * @param numThreads the number of threads to use (0 = number of cores).
+   * @return the ephemeris, with satellite i at index i.
+   */
+  static Ptr<SatelliteEphemeris> Build (
+    const std::vector<Ptr<Satellite> > &satellites,
+    const std::vector<JulianDate> &starts,
+    const Time &duration, const Time &interval, uint32_t numThreads
+  );
+
+  /**
+   * @brief Save the ephemeris to a binary file.
+   * @param filename the file to write.
+   */
+  void Save (const std::string &filename) const;
+
+  /**
+   * @brief Load an ephemeris from a binary file written by Save(), by mapping
+   *        it read-only into memory.
+   * @param filename the file to map.
+   * @return the ephemeris.
+   * @throws std::runtime_error if the file cannot be read, or is not an
+   *         ephemeris file of this version (magic, header or size).
+   */
+  static Ptr<SatelliteEphemeris> Load (const std::string &filename);
+
+  /**
+   * @brief Get the epoch field of a TLE.
+   * @param line1 the first TLE line.
+   * @return the epoch as in the TLE (YYDDD.DDDDDDDD).
+   */
+  static double ParseTleEpoch (const std::string &line1);
+
+  /**
+   * @brief Hash the two lines of a TLE (64-bit FNV-1a).
+   * @param line1 the first TLE line.
+   * @param line2 the second TLE line.
+   * @return the hash.
+   */
+  static uint64_t HashTle (const std::string &line1, const std::string &line2);
+
+  /**
+   * @brief Check whether the samples are mapped from a file.
+   * @return true if the ephemeris was loaded from a file.
+   */
+  bool IsMapped (void) const;
+
+  /**
+   * @brief Get the number of satellites.
+   * @return the number of satellites.
+   */
+  uint32_t GetNSatellites (void) const;
+
+  /**
+   * @brief Get the number of samples per satellite.
+   * @return the number of samples per satellite.
+   */
+  uint32_t GetNSamples (void) const;
+
+  /**
+   * @brief Get the interval between two samples.
+   * @return the sample interval.
+   */
+  Time GetInterval (void) const;
+
+  /**
+   * @brief Get the maximum measured interpolation error of a satellite.
+   * @param index the satellite index.
+   * @return the error bound in meters.
+   */
+  double GetErrorBound (uint32_t index) const;
+
+  /**
+   * @brief Get the maximum measured interpolation error over all satellites.
+   * @return the error bound in meters.
+   */
+  double GetMaxErrorBound (void) const;
+
+  /**
+   * @brief Get the TLE epoch of a satellite.
+   * @param index the satellite index.
+   * @return the epoch as in the TLE (YYDDD.DDDDDDDD).
+   */
+  double GetTleEpoch (uint32_t index) const;
+
+  /**
+   * @brief Get the hash of the TLE of a satellite.
+   * @param index the satellite index.
+   * @return the hash (see HashTle).
+   */
+  uint64_t GetTleHash (uint32_t index) const;
+
+  /**
+   * @brief Interpolate the position and/or velocity of a satellite.
+   * @param index the satellite index.
+   * @param t simulation time.
+   * @param position if not null, set to the interpolated position (m).
+   * @param velocity if not null, set to the interpolated velocity (m/s).
+   * @return true if t is within the sampled range.
+   */
+  bool Interpolate (uint32_t index, const Time &t, Vector3D *position, Vector3D *velocity) const;
+
+  /**
+   * @brief Cubic Hermite interpolation between two samples.
+   * @param a the sample at the start of the interval.
+   * @param b the sample at the end of the interval.
+   * @param dt the length of the interval (s).
+   * @param s the fraction of the interval, in [0, 1].
+   * @param position if not null, set to the interpolated position.
+   * @param velocity if not null, set to the interpolated velocity.
+   */
+  static void Hermite (const double *a, const double *b, double dt, double s,
+                       Vector3D *position, Vector3D *velocity);
+
+private:
+  uint32_t m_nSatellites;               //!< number of satellites
+  uint32_t m_nSamples;                  //!< number of samples per satellite
+  int64_t m_intervalNs;                 //!< interval between samples (ns)
+  std::vector<double> m_samples;        //!< [satellite][sample][value] (if built)
+  std::vector<double> m_errorBounds;    //!< error bound per satellite (m)
+  std::vector<double> m_tleEpochs;      //!< TLE epoch per satellite (YYDDD.DDDDDDDD)
+  std::vector<uint64_t> m_tleHashes;    //!< TLE hash per satellite
+  const double *m_data;                 //!< the samples, built or mapped
+  void *m_mapping;                      //!< mapped file (null if built)
+  size_t m_mappingSize;                 //!< size of the mapped file
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_EPHEMERIS_H */
@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "satellite-position-cache.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SatellitePositionCache");
+
+NS_OBJECT_ENSURE_REGISTERED (SatellitePositionCache);
+
+TypeId
+SatellitePositionCache::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SatellitePositionCache")
+    .SetParent<Object> ()
+    .SetGroupName ("Mobility")
+    .AddConstructor<SatellitePositionCache> ()
+    .AddAttribute ("Quantum",
+                   "Length of the time quantum within which a satellite is propagated at most once",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&SatellitePositionCache::SetQuantum,
+                                     &SatellitePositionCache::GetQuantum),
+                   MakeTimeChecker ())
+  ;
+
+  return tid;
+}
+
+SatellitePositionCache::SatellitePositionCache (void)
+  : m_quantumNs (1000000), m_hits (0), m_misses (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SatellitePositionCache::~SatellitePositionCache (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Time
+SatellitePositionCache::GetQuantum (void) const
+{
+  return NanoSeconds (m_quantumNs);
+}
+
+void
+SatellitePositionCache::SetQuantum (const Time &quantum)
+{
+  NS_ABORT_MSG_UNLESS (quantum.GetNanoSeconds () > 0,
+                       "The satellite position cache quantum must be at least 1 ns.");
+  m_quantumNs = quantum.GetNanoSeconds ();
+}
+
+int64_t
+SatellitePositionCache::GetQuantumIndex (const Time &t) const
+{
+  return t.GetNanoSeconds () / m_quantumNs;
+}
+
+Time
+SatellitePositionCache::GetQuantumStart (int64_t index) const
+{
+  return NanoSeconds (index * m_quantumNs);
+}
+
+void
+SatellitePositionCache::NotifyHit (void)
+{
+  m_hits++;
+}
+
+void
+SatellitePositionCache::NotifyMiss (void)
+{
+  m_misses++;
+}
+
+uint64_t
+SatellitePositionCache::GetHits (void) const
+{
+  return m_hits;
+}
+
+uint64_t
+SatellitePositionCache::GetMisses (void) const
+{
+  return m_misses;
+}
+
+void
+SatellitePositionCache::ResetStatistics (void)
+{
+  m_hits = 0;
+  m_misses = 0;
+}
+
+} // namespace ns3
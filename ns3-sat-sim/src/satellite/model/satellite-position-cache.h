@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SATELLITE_POSITION_CACHE_H
+#define SATELLITE_POSITION_CACHE_H
+
+#include <stdint.h>
+
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/type-id.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * @brief Constellation-wide cache policy for satellite positions.
+ *
+ * Simulation time is divided into quanta of a configurable length. A
+ * SatellitePositionMobilityModel that is attached to a cache propagates its
+ * satellite at most once per quantum (at the start of the quantum) and serves
+ * every other position or velocity query within that quantum from the stored
+ * result. A single cache object is meant to be shared by all the satellites of
+ * a constellation, such that the quantum is uniform and the hit/miss counters
+ * cover every channel that queries satellite positions.
+ *
+ * Positions served from the cache are those at the start of the quantum, so
+ * the cache trades accuracy for fewer propagations: a LEO satellite moves
+ * about 7.5 m per millisecond of quantum. Without the cache, a satellite is
+ * propagated to the exact (nanosecond) simulation time.
+ */
+class SatellitePositionCache : public Object {
+public:
+  /**
+   * @brief Get the type ID.
+   * @return the object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * @brief Default constructor.
+   */
+  SatellitePositionCache (void);
+
+  /**
+   * @brief Destructor.
+   */
+  virtual ~SatellitePositionCache (void);
+
+  /**
+   * @brief Get the length of a quantum.
+   * @return the length of a quantum.
+   */
+  Time GetQuantum (void) const;
+
+  /**
+   * @brief Set the length of a quantum.
+   * @param quantum the length of a quantum (must be strictly positive).
+   */
+  void SetQuantum (const Time &quantum);
+
+  /**
+   * @brief Get the index of the quantum a simulation time falls in.
+   * @param t the simulation time (must not be negative).
+   * @return the quantum index.
+   */
+  int64_t GetQuantumIndex (const Time &t) const;
+
+  /**
+   * @brief Get the simulation time at which a quantum starts.
+   * @param index the quantum index.
+   * @return the start time of the quantum.
+   */
+  Time GetQuantumStart (int64_t index) const;
+
+  /**
+   * @brief Record a query that was served from the cache.
+   */
+  void NotifyHit (void);
+
+  /**
+   * @brief Record a query that required a propagation.
+   */
+  void NotifyMiss (void);
+
+  /**
+   * @brief Get the number of queries that were served from the cache.
+   * @return the number of cache hits.
+   */
+  uint64_t GetHits (void) const;
+
+  /**
+   * @brief Get the number of queries that required a propagation.
+   * @return the number of cache misses.
+   */
+  uint64_t GetMisses (void) const;
+
+  /**
+   * @brief Reset the hit and miss counters to zero.
+   */
+  void ResetStatistics (void);
+
+private:
+  int64_t m_quantumNs;      //!< length of a quantum in nanoseconds.
+  uint64_t m_hits;          //!< number of cache hits.
+  uint64_t m_misses;        //!< number of cache misses.
+};
+
+} // namespace ns3
+
+#endif /* SATELLITE_POSITION_CACHE_H */
@@ -30,11 +30,13 @@ namespace ns3 {
 ATTRIBUTE_HELPER_CPP (SatellitePositionHelper);
 
 SatellitePositionHelper::SatellitePositionHelper (void)
+  : m_epochOffsetNs (0)
 {
   SetStartTime (JulianDate ());
 }
 
 SatellitePositionHelper::SatellitePositionHelper (Ptr<Satellite> sat)
+  : m_epochOffsetNs (0)
 {
   SetSatellite (sat);
   SetStartTime (sat->GetTleEpoch ());
@@ -43,6 +45,7 @@ SatellitePositionHelper::SatellitePositionHelper (Ptr<Satellite> sat)
 SatellitePositionHelper::SatellitePositionHelper(
   Ptr<Satellite> sat, const JulianDate &t
 )
+  : m_epochOffsetNs (0)
 {
   SetSatellite (sat);
   SetStartTime (t);
@@ -50,24 +53,69 @@ SatellitePositionHelper::SatellitePositionHelper(
 
 Vector3D
 SatellitePositionHelper::GetPosition (void) const
+{
+  return GetPosition (Simulator::Now ());
+}
+
+Vector3D
+SatellitePositionHelper::GetVelocity (void) const
+{
+  return GetVelocity (Simulator::Now ());
+}
+
+Vector3D
+SatellitePositionHelper::GetPosition (const Time &t) const
 {
   if (!m_sat)
     return Vector3D (0,0,0);
 
-  JulianDate cur = m_start + Simulator::Now ();
+  int64_t ns = t.GetNanoSeconds ();
 
-  return m_sat->GetPosition (cur);
+  return m_sat->GetPosition (GetTimeSinceEpoch (ns), FrameTransform::TemeToItrf (m_start, ns));
 }
 
 Vector3D
-SatellitePositionHelper::GetVelocity (void) const
+SatellitePositionHelper::GetVelocity (const Time &t) const
 {
   if (!m_sat)
     return Vector3D (0,0,0);
 
-  JulianDate cur = m_start + Simulator::Now ();
+  int64_t ns = t.GetNanoSeconds ();
+
+  return m_sat->GetVelocity (GetTimeSinceEpoch (ns), FrameTransform::TemeToItrf (m_start, ns));
+}
+
+Satellite::State
+SatellitePositionHelper::GetState (void) const
+{
+  return GetState (Simulator::Now ());
+}
 
-  return m_sat->GetVelocity (cur);
+Satellite::State
+SatellitePositionHelper::GetState (const Time &t) const
+{
+  if (!m_sat)
+    return Satellite::State ();
+
+  int64_t ns = t.GetNanoSeconds ();
+
+  return m_sat->GetState (GetTimeSinceEpoch (ns), FrameTransform::TemeToItrf (m_start, ns));
+}
+
+double
+SatellitePositionHelper::GetTimeSinceEpoch (int64_t ns) const
+{
+  // ns -> min
+  return (m_epochOffsetNs + ns) / 6e10;
+}
+
+void
+SatellitePositionHelper::UpdateEpochOffset (void)
+{
+  if (m_sat && m_sat->IsInitialized ())
+    m_epochOffsetNs = (m_start - m_sat->GetTleEpoch ()).GetNanoSeconds ();
+  else
+    m_epochOffsetNs = 0;
 }
 
 Ptr<Satellite>
@@ -92,12 +140,14 @@ void
 SatellitePositionHelper::SetSatellite (Ptr<Satellite> sat)
 {
   m_sat = sat;
+  UpdateEpochOffset ();
 }
 
 void
 SatellitePositionHelper::SetStartTime (const JulianDate &t)
 {
   m_start = t;
+  UpdateEpochOffset ();
 }
 
 std::ostream
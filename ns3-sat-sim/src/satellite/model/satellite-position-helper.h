@@ -23,6 +23,7 @@
 #ifndef SATELLITE_POSITION_HELPER_MODEL_H
 #define SATELLITE_POSITION_HELPER_MODEL_H
 
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/vector.h"
 #include "ns3/attribute.h"
@@ -37,6 +38,13 @@ namespace ns3 {
  *
  * @brief Utility class used to interface between SatellitePositionMobilityModel
  *        and Satellite classes.
+ *
+ * Simulation times are mapped to SGP4 time since TLE epoch directly from
+ * integer nanoseconds, using the offset between the simulation start and the
+ * TLE epoch that is computed once when the satellite or start time is set
+ * (so the satellite's TLE must be set before it is handed to the helper).
+ * This avoids JulianDate arithmetic per query and, unlike JulianDate, does
+ * not quantize the time to milliseconds.
  */
 class SatellitePositionHelper {
 public:
@@ -70,6 +78,34 @@ public:
    */
   Vector3D GetVelocity (void) const;
 
+  /**
+   * @brief Get orbital position vector (x, y, z) at a given simulation time.
+   * @param t simulation time (relative to the simulation's start time).
+   * @return orbital position vector.
+   */
+  Vector3D GetPosition (const Time &t) const;
+
+  /**
+   * @brief Get orbital velocity at a given simulation time.
+   * @param t simulation time (relative to the simulation's start time).
+   * @return orbital velocity vector.
+   */
+  Vector3D GetVelocity (const Time &t) const;
+
+  /**
+   * @brief Get current orbital position and velocity (one propagation).
+   * @return orbital position and velocity vectors.
+   */
+  Satellite::State GetState (void) const;
+
+  /**
+   * @brief Get orbital position and velocity at a given simulation time (one
+   *        propagation).
+   * @param t simulation time (relative to the simulation's start time).
+   * @return orbital position and velocity vectors.
+   */
+  Satellite::State GetState (const Time &t) const;
+
   /**
    * @brief Get satellite's name.
    * @return satellite's name or an empty string if the satellite object is not
@@ -102,8 +138,21 @@ public:
   void SetStartTime(const JulianDate &t);
 
 private:
+  /**
+   * @brief Convert a simulation time into SGP4 time since TLE epoch.
+   * @param ns simulation time (ns).
+   * @return time since TLE epoch (minutes).
+   */
+  double GetTimeSinceEpoch (int64_t ns) const;
+
+  /**
+   * @brief Recompute the offset between simulation start and TLE epoch.
+   */
+  void UpdateEpochOffset (void);
+
   Ptr<Satellite> m_sat;               //!< pointer to the Satellite object.
   JulianDate m_start;                         //!< simulation's absolute start time.
+  int64_t m_epochOffsetNs;            //!< simulation start - TLE epoch (ns).
 };
 
 /**
@@ -24,8 +24,10 @@
 
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
 #include "ns3/ptr.h"
 #include "ns3/satellite.h"
+#include "ns3/simulator.h"
 #include "ns3/type-id.h"
 
 namespace ns3 {
@@ -45,12 +47,19 @@ SatellitePositionMobilityModel::GetTypeId (void) {
                   SatellitePositionHelperValue(SatellitePositionHelper()),
                   MakeSatellitePositionHelperAccessor (&SatellitePositionMobilityModel::m_helper),
                   MakeSatellitePositionHelperChecker())
+    .AddAttribute("PositionCache",
+                  "The (shared) position cache, if set the satellite is propagated at most once per cache quantum",
+                  PointerValue (),
+                  MakePointerAccessor (&SatellitePositionMobilityModel::SetPositionCache,
+                                       &SatellitePositionMobilityModel::GetPositionCache),
+                  MakePointerChecker<SatellitePositionCache> ())
   ;
 
   return tid;
 }
 
-SatellitePositionMobilityModel::SatellitePositionMobilityModel (void) { }
+SatellitePositionMobilityModel::SatellitePositionMobilityModel (void)
+  : m_stateQuantum (-1) { }
 SatellitePositionMobilityModel::~SatellitePositionMobilityModel (void) { }
 
 std::string
@@ -75,18 +84,68 @@ void
 SatellitePositionMobilityModel::SetSatellite (Ptr<Satellite> sat)
 {
   m_helper.SetSatellite (sat);
+  m_stateQuantum = -1;
 }
 
 void
 SatellitePositionMobilityModel::SetStartTime (const JulianDate &t)
 {
   m_helper.SetStartTime (t);
+  m_stateQuantum = -1;
+}
+
+Ptr<SatellitePositionCache>
+SatellitePositionMobilityModel::GetPositionCache (void) const
+{
+  return m_cache;
+}
+
+void
+SatellitePositionMobilityModel::SetPositionCache (Ptr<SatellitePositionCache> cache)
+{
+  m_cache = cache;
+  m_stateQuantum = -1;
+}
+
+Satellite::State
+SatellitePositionMobilityModel::GetState (void) const
+{
+  if (!m_cache)
+    return m_helper.GetState ();
+
+  return GetCachedState ();
+}
+
+Vector3D
+SatellitePositionMobilityModel::GetPositionAt (const Time &t) const
+{
+  return m_helper.GetPosition (t);
+}
+
+const Satellite::State&
+SatellitePositionMobilityModel::GetCachedState (void) const
+{
+  int64_t quantum = m_cache->GetQuantumIndex (Simulator::Now ());
+  if (quantum == m_stateQuantum)
+    {
+      m_cache->NotifyHit ();
+      return m_state;
+    }
+
+  m_cache->NotifyMiss ();
+  m_state = m_helper.GetState (m_cache->GetQuantumStart (quantum));
+  m_stateQuantum = quantum;
+
+  return m_state;
 }
 
 Vector3D
 SatellitePositionMobilityModel::DoGetPosition (void) const
 {
-  return m_helper.GetPosition ();
+  if (!m_cache)
+    return m_helper.GetPosition ();
+
+  return GetCachedState ().position;
 }
 
 void
@@ -99,7 +158,10 @@ SatellitePositionMobilityModel::DoSetPosition (const Vector3D &position)
 Vector3D
 SatellitePositionMobilityModel::DoGetVelocity (void) const
 {
-  return m_helper.GetVelocity ();
+  if (!m_cache)
+    return m_helper.GetVelocity ();
+
+  return GetCachedState ().velocity;
 }
 
 }
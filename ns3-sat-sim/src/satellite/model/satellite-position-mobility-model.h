@@ -30,6 +30,7 @@
 #include "ns3/satellite.h"
 #include "ns3/type-id.h"
 
+#include "satellite-position-cache.h"
 #include "satellite-position-helper.h"
 
 namespace ns3 {
@@ -47,6 +48,12 @@ namespace ns3 {
  * The DoSetPosition function has no effect because a satellite orbit cannot be
  * specified solely by a 3D position. When setting up Satellite objects, bear in
  * mind that it provides maximum accuracy at TLE epoch.
+ *
+ * Optionally, a SatellitePositionCache can be attached, in which case the
+ * satellite is propagated at most once per cache quantum and all other queries
+ * within the same quantum are answered with the stored position and velocity.
+ * Position and velocity are always propagated together (GetState), so asking
+ * for both within a quantum costs a single propagation.
  */
 class SatellitePositionMobilityModel : public MobilityModel {
 public:
@@ -96,12 +103,49 @@ public:
    */
   void SetStartTime (const JulianDate &t);
 
+  /**
+   * @brief Get the position cache this model is attached to.
+   * @return a pointer to the position cache, or 0 if caching is disabled.
+   */
+  Ptr<SatellitePositionCache> GetPositionCache (void) const;
+
+  /**
+   * @brief Attach the model to a (shared) position cache.
+   * @param cache a pointer to the position cache, or 0 to disable caching.
+   */
+  void SetPositionCache (Ptr<SatellitePositionCache> cache);
+
+  /**
+   * @brief Get the current position and velocity with a single propagation.
+   * @return the current position (m) and velocity (m/s).
+   */
+  Satellite::State GetState (void) const;
+
+  /**
+   * @brief Get the position at an arbitrary simulation time (exact, does not
+   *        use the position cache).
+   * @param t simulation time.
+   * @return the position (m).
+   */
+  Vector3D GetPositionAt (const Time &t) const;
+
 private:
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
 
+  /**
+   * @brief Get the state at the start of the current cache quantum,
+   *        propagating only if it is not yet cached.
+   * @return the cached position and velocity.
+   */
+  const Satellite::State& GetCachedState (void) const;
+
   SatellitePositionHelper m_helper;     //!< helper for orbital computations
+  Ptr<SatellitePositionCache> m_cache;  //!< shared position cache (optional)
+
+  mutable int64_t m_stateQuantum;       //!< quantum of the cached state
+  mutable Satellite::State m_state;     //!< cached position and velocity
 };
 
 } // namespace ns3
@@ -91,46 +91,94 @@ Satellite::GetTleEpoch (void) const {
   return JulianDate ();
 }
 
+const elsetrec&
+Satellite::GetSgp4Record (void) const
+{
+  return m_sgp4_record;
+}
+
 Vector3D
 Satellite::GetPosition (const JulianDate &t) const
+{
+  return GetPosition ((t - GetTleEpoch ()).GetMinutes (), FrameTransform::TemeToItrf (t));
+}
+
+Vector3D
+Satellite::GetVelocity (const JulianDate &t) const
+{
+  return GetVelocity ((t - GetTleEpoch ()).GetMinutes (), FrameTransform::TemeToItrf (t));
+}
+
+Satellite::State
+Satellite::GetState (const JulianDate &t) const
+{
+  return GetState ((t - GetTleEpoch ()).GetMinutes (), FrameTransform::TemeToItrf (t));
+}
+
+Vector3D
+Satellite::GetPosition (double tsince, const FrameTransform &transform) const
 {
   double r[3], v[3];
-  //double delta = (t - GetTleEpoch ())*1440;
-  double delta = (t - GetTleEpoch ()).GetMinutes();
 
   if (!IsInitialized ())
     return Vector3D ();
 
-  sgp4 (WGeoSys, m_sgp4_record, delta, r, v);
+  sgp4 (WGeoSys, m_sgp4_record, tsince, r, v);
 
   if (m_sgp4_record.error != 0)
     return Vector3D ();
 
   // vector r is in km so it needs to be converted to meters
-  return rTemeTorItrf (Vector3D (r[0], r[1], r[2]), t)*1000;
+  return transform.TransformPosition (Vector3D (r[0], r[1], r[2]))*1000;
 }
 
 Vector3D
-Satellite::GetVelocity (const JulianDate &t) const
+Satellite::GetVelocity (double tsince, const FrameTransform &transform) const
 {
   double r[3], v[3];
-  //double delta = (t - GetTleEpoch ())*1440;
-  double delta = (t - GetTleEpoch ()).GetMinutes();
 
   if (!IsInitialized ())
     return Vector3D ();
 
-  sgp4 (WGeoSys, m_sgp4_record, delta, r, v);
+  sgp4 (WGeoSys, m_sgp4_record, tsince, r, v);
 
   if (m_sgp4_record.error != 0)
     return Vector3D ();
 
   // velocity vector is in km/s so it needs to be converted to m/s
-  return 1000*rvTemeTovItrf (
-    Vector3D (r[0], r[1], r[2]), Vector3D (v[0], v[1], v[2]), t
+  return 1000*transform.TransformVelocity (
+    Vector3D (r[0], r[1], r[2]), Vector3D (v[0], v[1], v[2])
   );
 }
 
+Satellite::State
+Satellite::GetState (double tsince, const FrameTransform &transform) const
+{
+  double r[3], v[3];
+  State state;
+
+  if (!IsInitialized ())
+    return state;
+
+  sgp4 (WGeoSys, m_sgp4_record, tsince, r, v);
+
+  if (m_sgp4_record.error != 0)
+    return state;
+
+  // km -> m and km/s -> m/s, both with the same frame transform
+  Vector3D rteme (r[0], r[1], r[2]);
+  state.position = transform.TransformPosition (rteme)*1000;
+  state.velocity = 1000*transform.TransformVelocity (rteme, Vector3D (v[0], v[1], v[2]));
+
+  return state;
+}
+
+Vector3D
+Satellite::GetGeographicPosition (const JulianDate &t) const
+{
+  return ItrfToGeographic (GetPosition (t));
+}
+
 /*
  * This function uses the WGS84 constants as defined by the National
  * Geospatial-Intelligence Agency (NGA) on the report published on 2014-07-08
@@ -146,13 +194,12 @@ Satellite::GetVelocity (const JulianDate &t) const
  * [the URL was split to fit page limits]
  */
 Vector3D
-Satellite::GetGeographicPosition (const JulianDate &t) const
+Satellite::ItrfToGeographic (const Vector3D &r)
 {
   const double a = 6378137.0;                   // equatorial radius (m)
   const double b = 6356752.31424518;            // polar radius (m)
   const double fes = 6.694379990141e-03;        // first eccentricity squared
   const double ses = 6.739496742276e-03;        // second eccentricity squared
-  Vector3D r = GetPosition (t);
   const double p = sqrt (r.x*r.x + r.y*r.y);
   const double th = atan2 (a*r.z, b*p);
   const double sinth = sin (th);
@@ -253,110 +300,4 @@ Satellite::IsInitialized (void) const
   return ((m_sgp4_record.jdsatepoch > 0) && (m_tle1 != "") && (m_tle2 != ""));
 }
 
-Satellite::Matrix
-Satellite::PefToItrf (const JulianDate &t)
-{
-  std::pair<double, double> eop = t.GetPolarMotion ();
-
-  const double &xp = eop.first, &yp = eop.second;
-  const double cosxp = cos (xp), cosyp = cos (yp);
-  const double sinxp = sin (xp), sinyp = sin (yp);
-
-  // [from AIAA-2006-6753 Report, Page 32, Appendix C - TEME Coordinate System]
-  //
-  // Matrix(ITRF<->PEF) = ROT1(yp)*ROT2(xp) [using c for cos, and s for sin]
-  //
-  // | 1    0     0   |*| c(xp) 0 -s(xp) |=|    c(xp)       0      -s(xp)   |
-  // | 0  c(yp) s(yp) | |   0   1    0   | | s(yp)*s(xp)  c(yp) s(yp)*c(xp) |
-  // | 0 -s(yp) c(yp) | | s(xp) 0  c(xp) | | c(yp)*s(xp) -s(yp) c(yp)*c(xp) |
-  //
-
-  // we return the transpose because it is what's needed
-  return Matrix(
-     cosxp, sinyp*sinxp, cosyp*sinxp,
-       0,      cosyp,      -sinyp,
-    -sinxp, sinyp*cosxp, cosyp*cosxp
-  );
-}
-
-Satellite::Matrix
-Satellite::TemeToPef (const JulianDate &t)
-{
-  const double gmst = t.GetGmst ();
-  const double cosg = cos (gmst), sing = sin (gmst);
-
-  // [from AIAA-2006-6753 Report, Page 32, Appendix C - TEME Coordinate System]
-  //
-  // rPEF = ROT3(gmst)*rTEME
-  //
-  // |  cos(gmst) sin(gmst) 0 |
-  // | -sin(gmst) cos(gmst) 0 |
-  // |      0         0     1 |
-  //
-
-  return Matrix(
-     cosg, sing, 0,
-    -sing, cosg, 0,
-       0,    0,  1
-  );
-}
-
-Vector3D
-Satellite::rTemeTorItrf (const Vector3D &rteme, const JulianDate &t)
-{
-  Matrix pmt = PefToItrf (t);                   // PEF->ITRF matrix transposed
-  Matrix tmt = TemeToPef (t);                   // TEME->PEF matrix
-
-  return pmt*(tmt*rteme);
-}
-
-Vector3D
-Satellite::rvTemeTovItrf(
-  const Vector3D &rteme, const Vector3D &vteme, const JulianDate &t
-)
-{
-  Matrix pmt = PefToItrf (t);                   // PEF->ITRF matrix transposed
-  Matrix tmt = TemeToPef (t);                   // TEME->PEF matrix
-  Vector3D w (0.0, 0.0, t.GetOmegaEarth ());
-
-  return pmt*((tmt*vteme) - CrossProduct (w, tmt*rteme));
-}
-
-Satellite::Matrix::Matrix (
-  double c00, double c01, double c02,
-  double c10, double c11, double c12,
-  double c20, double c21, double c22
-)
-{
-  m[0][0] = c00;
-  m[0][1] = c01;
-  m[0][2] = c02;
-  m[1][0] = c10;
-  m[1][1] = c11;
-  m[1][2] = c12;
-  m[2][0] = c20;
-  m[2][1] = c21;
-  m[2][2] = c22;
-}
-
-Vector3D
-Satellite::Matrix::operator* (const Vector3D& v) const
-{
-  return Vector3D (
-    m[0][0]*v.x + m[0][1]*v.y + m[0][2]*v.z,
-    m[1][0]*v.x + m[1][1]*v.y + m[1][2]*v.z,
-    m[2][0]*v.x + m[2][1]*v.y + m[2][2]*v.z
-  );
-}
-
-Satellite::Matrix
-Satellite::Matrix::Transpose (void) const
-{
-  return Matrix(
-    m[0][0], m[1][0], m[2][0],
-    m[0][1], m[1][1], m[2][1],
-    m[0][2], m[1][2], m[2][2]
-  );
-}
-
 }
@@ -31,6 +31,7 @@
 #include "ns3/type-id.h"
 #include "ns3/vector.h"
 
+#include "frame-transform.h"
 #include "julian-date.h"
 #include "sgp4ext.h"
 #include "sgp4io.h"
@@ -81,6 +82,12 @@ public:
   /// Satellite's information line size defined by TLE data format.
   static const uint32_t TleSatInfoWidth;
 
+  /// Satellite's position and velocity at a time instant (ITRF).
+  struct State {
+    Vector3D position;    //!< position (m)
+    Vector3D velocity;    //!< velocity (m/s)
+  };
+
   /**
    * @brief Get the type ID.
    * @return the object TypeId.
@@ -119,6 +126,13 @@ public:
    */
   JulianDate GetTleEpoch (void) const;
 
+  /**
+   * @brief Retrieve the SGP4/SDP4 record (orbital elements and model state).
+   * @return the SGP4/SDP4 record, which has a zero epoch (jdsatepoch) if the
+   *         satellite has not yet been initialized.
+   */
+  const elsetrec& GetSgp4Record (void) const;
+
   /**
    * @brief Get the prediction for the satellite's position at a given time.
    * @param t When.
@@ -135,6 +149,44 @@ public:
    */
   Vector3D GetVelocity (const JulianDate &t) const;
 
+  /**
+   * @brief Get the prediction for the satellite's position and velocity at a
+   *        given time, with a single propagation (cheaper than calling both
+   *        GetPosition and GetVelocity).
+   * @param t When.
+   * @return the satellite's position (m) and velocity (m/s) on ITRF
+   *         coordinate frame.
+   */
+  State GetState (const JulianDate &t) const;
+
+  /**
+   * @brief Get the prediction for the satellite's position at a given time
+   *        since TLE epoch (fast path without JulianDate arithmetic).
+   * @param tsince Time since TLE epoch (minutes).
+   * @param transform TEME to ITRF transform at the same time instant.
+   * @return the satellite's position (m) on ITRF coordinate frame.
+   */
+  Vector3D GetPosition (double tsince, const FrameTransform &transform) const;
+
+  /**
+   * @brief Get the prediction for the satellite's velocity at a given time
+   *        since TLE epoch (fast path without JulianDate arithmetic).
+   * @param tsince Time since TLE epoch (minutes).
+   * @param transform TEME to ITRF transform at the same time instant.
+   * @return the satellite's velocity (m/s) on ITRF coordinate frame.
+   */
+  Vector3D GetVelocity (double tsince, const FrameTransform &transform) const;
+
+  /**
+   * @brief Get the prediction for the satellite's position and velocity at a
+   *        given time since TLE epoch (fast path without JulianDate arithmetic).
+   * @param tsince Time since TLE epoch (minutes).
+   * @param transform TEME to ITRF transform at the same time instant.
+   * @return the satellite's position (m) and velocity (m/s) on ITRF
+   *         coordinate frame.
+   */
+  State GetState (double tsince, const FrameTransform &transform) const;
+
   /**
    * @brief Get the predicted satellite's geographic position at a given time.
    * @param t When.
@@ -144,6 +196,15 @@ public:
    */
   Vector3D GetGeographicPosition (const JulianDate &t) const;
 
+  /**
+   * @brief Convert an ITRF position into a geographic position.
+   * @param r the position (m) on ITRF coordinate frame.
+   * @return an ns3::Vector3D object containing the geographic position:
+   *         x = latitude (in degrees), y = longitude (in degrees), and
+   *         z = altitude (in meters) on WGS84 format.
+   */
+  static Vector3D ItrfToGeographic (const Vector3D &r);
+
   /**
    * @brief Get the satellite's orbital period.
    * @return an ns3::Time object containing the satellite's orbital period.
@@ -164,6 +225,12 @@ public:
    */
   bool SetTleInfo (const std::string &line1, const std::string &line2);
 
+  /**
+   * @brief Check if the satellite has already been initialized.
+   * @return a boolean indicating whether the satellite is initialized.
+   */
+  bool IsInitialized (void) const;
+
   /**
    * @brief Extract the satellite's name from a string.
    * @param name String containing the satellite's name.
@@ -181,72 +248,6 @@ public:
   static std::string ExtractTleSatInfo (const std::string &info);
 
 private:
-  /// row of a Matrix
-  struct Row {
-    double r[3];
-
-    double& operator[] (uint32_t i) { return r[i]; }
-    const double& operator[] (uint32_t i) const { return r[i]; }
-  };
-
-  /// Matrix data structure to make coordinate conversion code clearer and
-  /// less verbose
-  struct Matrix {
-  public:
-    Matrix (void) { }
-    Matrix (
-      double c00, double c01, double c02,
-      double c10, double c11, double c12,
-      double c20, double c21, double c22
-    );
-
-    Row& operator[] (uint32_t i) { return m[i]; }
-    const Row& operator[] (uint32_t i) const { return m[i]; }
-
-    Vector3D operator* (const Vector3D &v) const;
-
-    Matrix Transpose (void) const;
-
-  private:
-    Row m[3];
-  };
-
-  /**
-   * @brief Check if the satellite has already been initialized.
-   * @return a boolean indicating whether the satellite is initialized.
-   */
-  bool IsInitialized (void) const;
-
-  /**
-   * @brief Retrieve the matrix for converting from PEF to ITRF at a given time.
-   * @param t When.
-   * @return the PEF-ITRF conversion matrix.
-   */
-  static Matrix PefToItrf (const JulianDate &t);
-
-  /**
-   * @brief Retrieve the matrix for converting from TEME to PEF at a given time.
-   * @param t When.
-   * @return the TEME-PEF conversion matrix.
-   */
-  static Matrix TemeToPef (const JulianDate &t);
-
-  /**
-   * @brief Retrieve the satellite's position vector in ITRF coordinates.
-   * @param t When.
-   * @return the satellite's position vector in ITRF coordinates (meters).
-   */
-  static Vector3D rTemeTorItrf (const Vector3D &rteme, const JulianDate &t);
-
-  /**
-   * @brief Retrieve the satellite's velocity vector in ITRF coordinates.
-   * @param t When.
-   * @return the satellite's velocity vector in ITRF coordinates (m/s).
-   */
-  static Vector3D rvTemeTovItrf (
-    const Vector3D &rteme, const Vector3D &vteme, const JulianDate& t
-  );
-
   std::string m_name;                               //!< satellite's name.
   std::string m_tle1, m_tle2;                       //!< satellite's TLE data.
   mutable elsetrec m_sgp4_record;                   //!< SGP4/SDP4 record.
@@ -0,0 +1,277 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "sgp4-batch-propagator.h"
+
+#include <cmath>
+
+namespace ns3 {
+
+Sgp4BatchPropagator::Sgp4BatchPropagator (gravconsttype whichconst)
+  : m_n (0), m_whichconst (whichconst)
+{
+  double tumin, mu, j3, j4, j3oj2;
+  getgravconst (whichconst, tumin, mu, m_radiusEarthKm, m_xke, m_j2, j3, j4, j3oj2);
+  m_vKmPerSec = m_radiusEarthKm * m_xke/60.0;
+}
+
+uint32_t
+Sgp4BatchPropagator::Add (const elsetrec &satrec)
+{
+  uint32_t index = m_n++;
+
+  if (satrec.method == 'd')
+    {
+      m_deepSpaceIndex.push_back (index);
+      m_deepSpaceRecords.push_back (satrec);
+      return index;
+    }
+
+  // The simplified drag model drops the higher order terms, which is the
+  // same as evaluating them with zero coefficients
+  bool simple = (satrec.isimp == 1);
+
+  m_index.push_back (index);
+  m_mo.push_back (satrec.mo);
+  m_mdot.push_back (satrec.mdot);
+  m_argpo.push_back (satrec.argpo);
+  m_argpdot.push_back (satrec.argpdot);
+  m_nodeo.push_back (satrec.nodeo);
+  m_nodedot.push_back (satrec.nodedot);
+  m_nodecf.push_back (satrec.nodecf);
+  m_cc1.push_back (satrec.cc1);
+  m_bstarCc4.push_back (satrec.bstar * satrec.cc4);
+  m_bstarCc5.push_back (simple ? 0.0 : satrec.bstar * satrec.cc5);
+  m_t2cof.push_back (satrec.t2cof);
+  m_t3cof.push_back (simple ? 0.0 : satrec.t3cof);
+  m_t4cof.push_back (simple ? 0.0 : satrec.t4cof);
+  m_t5cof.push_back (simple ? 0.0 : satrec.t5cof);
+  m_omgcof.push_back (simple ? 0.0 : satrec.omgcof);
+  m_eta.push_back (satrec.eta);
+  m_xmcof.push_back (simple ? 0.0 : satrec.xmcof);
+  m_delmo.push_back (satrec.delmo);
+  m_sinmao.push_back (satrec.sinmao);
+  m_d2.push_back (simple ? 0.0 : satrec.d2);
+  m_d3.push_back (simple ? 0.0 : satrec.d3);
+  m_d4.push_back (simple ? 0.0 : satrec.d4);
+  m_no.push_back (satrec.no);
+  m_ecco.push_back (satrec.ecco);
+  m_inclo.push_back (satrec.inclo);
+  m_sinio.push_back (sin (satrec.inclo));
+  m_cosio.push_back (cos (satrec.inclo));
+  m_aycof.push_back (satrec.aycof);
+  m_xlcof.push_back (satrec.xlcof);
+  m_con41.push_back (satrec.con41);
+  m_x1mth2.push_back (satrec.x1mth2);
+  m_x7thm1.push_back (satrec.x7thm1);
+
+  return index;
+}
+
+uint32_t
+Sgp4BatchPropagator::GetN (void) const
+{
+  return m_n;
+}
+
+uint32_t
+Sgp4BatchPropagator::GetNDeepSpace (void) const
+{
+  return m_deepSpaceIndex.size ();
+}
+
+void
+Sgp4BatchPropagator::Propagate (double tsince, double *r, double *v, int *error)
+{
+  const double twopi = 2.0 * pi;
+  const double x2o3 = 2.0 / 3.0;
+  const double xke = m_xke, j2 = m_j2;
+  const double radiusearthkm = m_radiusEarthKm, vkmpersec = m_vKmPerSec;
+
+  // Terms that only depend on time are shared by all satellites
+  const double t = tsince;
+  const double t2 = t * t;
+  const double t3 = t2 * t;
+  const double t4 = t3 * t;
+
+  // Near-Earth satellites: same computations as sgp4 () for method 'n'
+  const uint32_t n = m_index.size ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double *ri = r + 3 * m_index[i];
+      double *vi = v + 3 * m_index[i];
+      int err = 0;
+      double mrt = 0.0;
+
+      /* ------- update for secular gravity and atmospheric drag ----- */
+      double xmdf = m_mo[i] + m_mdot[i] * t;
+      double argpdf = m_argpo[i] + m_argpdot[i] * t;
+      double nodedf = m_nodeo[i] + m_nodedot[i] * t;
+      double nodem = nodedf + m_nodecf[i] * t2;
+      double tempa = 1.0 - m_cc1[i] * t;
+      double tempe = m_bstarCc4[i] * t;
+      double templ = m_t2cof[i] * t2;
+
+      double delomg = m_omgcof[i] * t;
+      double delmtemp = 1.0 + m_eta[i] * cos (xmdf);
+      double delm = m_xmcof[i] * (delmtemp * delmtemp * delmtemp - m_delmo[i]);
+      double temp = delomg + delm;
+      double mm = xmdf + temp;
+      double argpm = argpdf - temp;
+      tempa = tempa - m_d2[i] * t2 - m_d3[i] * t3 - m_d4[i] * t4;
+      tempe = tempe + m_bstarCc5[i] * (sin (mm) - m_sinmao[i]);
+      templ = templ + m_t3cof[i] * t3 + t4 * (m_t4cof[i] + t * m_t5cof[i]);
+
+      double nm = m_no[i];
+      if (nm <= 0.0)
+        err = 2;
+      double am = pow ((xke / nm), x2o3) * tempa * tempa;
+      nm = xke / pow (am, 1.5);
+      double em = m_ecco[i] - tempe;
+      if ((em >= 1.0) || (em < -0.001))
+        err = (err ? err : 1);
+      if (em < 1.0e-6)
+        em = 1.0e-6;
+      mm = mm + m_no[i] * templ;
+      double xlm = mm + argpm + nodem;
+
+      nodem = fmod (nodem, twopi);
+      argpm = fmod (argpm, twopi);
+      xlm = fmod (xlm, twopi);
+      mm = fmod (xlm - argpm - nodem, twopi);
+
+      /* -------------------- long period periodics ------------------ */
+      const double ep = em, xincp = m_inclo[i], argpp = argpm, nodep = nodem, mp = mm;
+      const double sinip = m_sinio[i], cosip = m_cosio[i];
+      double axnl = ep * cos (argpp);
+      temp = 1.0 / (am * (1.0 - ep * ep));
+      double aynl = ep * sin (argpp) + temp * m_aycof[i];
+      double xl = mp + argpp + nodep + temp * m_xlcof[i] * axnl;
+
+      /* --------------------- solve kepler's equation --------------- */
+      double u = fmod (xl - nodep, twopi);
+      double eo1 = u;
+      double sineo1 = 0.0, coseo1 = 0.0;
+      double tem5 = 9999.9;
+      int ktr = 1;
+      while ((fabs (tem5) >= 1.0e-12) && (ktr <= 10))
+        {
+          sineo1 = sin (eo1);
+          coseo1 = cos (eo1);
+          tem5 = 1.0 - coseo1 * axnl - sineo1 * aynl;
+          tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+          if (fabs (tem5) >= 0.95)
+            tem5 = tem5 > 0.0 ? 0.95 : -0.95;
+          eo1 = eo1 + tem5;
+          ktr = ktr + 1;
+        }
+
+      /* ------------- short period preliminary quantities ----------- */
+      double ecose = axnl * coseo1 + aynl * sineo1;
+      double esine = axnl * sineo1 - aynl * coseo1;
+      double el2 = axnl * axnl + aynl * aynl;
+      double pl = am * (1.0 - el2);
+      if (pl < 0.0)
+        err = (err ? err : 4);
+
+      if (!err)
+        {
+          double rl = am * (1.0 - ecose);
+          double rdotl = sqrt (am) * esine / rl;
+          double rvdotl = sqrt (pl) / rl;
+          double betal = sqrt (1.0 - el2);
+          temp = esine / (1.0 + betal);
+          double sinu = am / rl * (sineo1 - aynl - axnl * temp);
+          double cosu = am / rl * (coseo1 - axnl + aynl * temp);
+          double su = atan2 (sinu, cosu);
+          double sin2u = (cosu + cosu) * sinu;
+          double cos2u = 1.0 - 2.0 * sinu * sinu;
+          temp = 1.0 / pl;
+          double temp1 = 0.5 * j2 * temp;
+          double temp2 = temp1 * temp;
+
+          /* -------------- update for short period periodics ------------ */
+          mrt = rl * (1.0 - 1.5 * temp2 * betal * m_con41[i]) +
+                0.5 * temp1 * m_x1mth2[i] * cos2u;
+          su = su - 0.25 * temp2 * m_x7thm1[i] * sin2u;
+          double xnode = nodep + 1.5 * temp2 * cosip * sin2u;
+          double xinc = xincp + 1.5 * temp2 * cosip * sinip * cos2u;
+          double mvt = rdotl - nm * temp1 * m_x1mth2[i] * sin2u / xke;
+          double rvdot = rvdotl + nm * temp1 * (m_x1mth2[i] * cos2u +
+                         1.5 * m_con41[i]) / xke;
+
+          /* --------------------- orientation vectors ------------------- */
+          double sinsu = sin (su);
+          double cossu = cos (su);
+          double snod = sin (xnode);
+          double cnod = cos (xnode);
+          double sini = sin (xinc);
+          double cosi = cos (xinc);
+          double xmx = -snod * cosi;
+          double xmy = cnod * cosi;
+          double ux = xmx * sinsu + cnod * cossu;
+          double uy = xmy * sinsu + snod * cossu;
+          double uz = sini * sinsu;
+          double vx = xmx * cossu - cnod * sinsu;
+          double vy = xmy * cossu - snod * sinsu;
+          double vz = sini * cossu;
+
+          /* --------- position and velocity (in km and km/sec) ---------- */
+          ri[0] = (mrt * ux) * radiusearthkm;
+          ri[1] = (mrt * uy) * radiusearthkm;
+          ri[2] = (mrt * uz) * radiusearthkm;
+          vi[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+          vi[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+          vi[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+
+          // decaying satellite
+          if (mrt < 1.0)
+            err = 6;
+        }
+
+      if (err)
+        {
+          ri[0] = ri[1] = ri[2] = 0.0;
+          vi[0] = vi[1] = vi[2] = 0.0;
+        }
+      if (error)
+        error[m_index[i]] = err;
+    }
+
+  // Deep-space satellites: scalar path
+  for (uint32_t i = 0; i < m_deepSpaceIndex.size (); i++)
+    {
+      uint32_t index = m_deepSpaceIndex[i];
+      elsetrec &satrec = m_deepSpaceRecords[i];
+      double *ri = r + 3 * index;
+      double *vi = v + 3 * index;
+
+      sgp4 (m_whichconst, satrec, tsince, ri, vi);
+
+      if (satrec.error != 0)
+        {
+          ri[0] = ri[1] = ri[2] = 0.0;
+          vi[0] = vi[1] = vi[2] = 0.0;
+        }
+      if (error)
+        error[index] = satrec.error;
+    }
+}
+
+} // namespace ns3
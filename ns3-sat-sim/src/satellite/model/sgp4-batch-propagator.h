@@ -0,0 +1,116 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2020 ETH Zurich
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SGP4_BATCH_PROPAGATOR_H
+#define SGP4_BATCH_PROPAGATOR_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "sgp4unit.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup satellite
+ * @brief SGP4 propagator for a batch of satellites.
+ *
+ * The scalar sgp4() function works on one elsetrec at a time and evaluates
+ * every model branch per call. This propagator instead stores the elements of
+ * all near-Earth (SGP4) satellites as a structure of arrays, with the terms
+ * that only depend on the elements (e.g., sin/cos of the inclination) computed
+ * once, and propagates all of them to the same time in a single loop. The
+ * simplified drag model (isimp) is folded into the coefficients by zeroing the
+ * terms that do not apply, such that every satellite follows the same code
+ * path apart from the data-dependent branches that sgp4() also has: the
+ * iterative solution of Kepler's equation (up to 10 iterations) and the checks
+ * for invalid elements, which skip the rest of the computation for that
+ * satellite. The loop is therefore not suited for SIMD vectorization; the gain
+ * comes from the precomputed terms and the memory layout. Deep-space (SDP4)
+ * satellites, whose propagation requires resonance integration state, fall
+ * back to the scalar sgp4() function.
+ *
+ * The results are identical to those of sgp4() for the same elsetrec.
+ * Positions are in km and velocities in km/s, on the TEME frame.
+ */
+class Sgp4BatchPropagator {
+public:
+  /**
+   * @brief Create an empty batch.
+   * @param whichconst gravitational constants to use (must be the same as the
+   *        ones used to initialize the records that will be added).
+   */
+  Sgp4BatchPropagator (gravconsttype whichconst = wgs72);
+
+  /**
+   * @brief Add a satellite to the batch.
+   * @param satrec SGP4/SDP4 record initialized by sgp4init() or twoline2rv().
+   * @return the index of the satellite within the batch.
+   */
+  uint32_t Add (const elsetrec &satrec);
+
+  /**
+   * @brief Get the number of satellites in the batch.
+   * @return the number of satellites.
+   */
+  uint32_t GetN (void) const;
+
+  /**
+   * @brief Get the number of satellites that use the scalar deep-space path.
+   * @return the number of deep-space satellites.
+   */
+  uint32_t GetNDeepSpace (void) const;
+
+  /**
+   * @brief Propagate all satellites to the same time since their epoch.
+   * @param tsince time since the TLE epoch of each satellite (minutes).
+   * @param r output positions (km), 3 values (x, y, z) per satellite in the
+   *        order in which they were added.
+   * @param v output velocities (km/s), same layout as r.
+   * @param error if not null, output SGP4 error code per satellite (0 if none);
+   *        position and velocity of satellites with an error are set to 0.
+   */
+  void Propagate (double tsince, double *r, double *v, int *error = 0);
+
+private:
+  // Gravitational constants
+  double m_radiusEarthKm;   //!< radius of the earth (km)
+  double m_xke;             //!< reciprocal of tumin
+  double m_j2;              //!< un-normalized zonal harmonic j2
+  double m_vKmPerSec;       //!< velocity unit (km/s)
+
+  uint32_t m_n;             //!< number of satellites in the batch
+
+  // Near-Earth satellites (structure of arrays)
+  std::vector<uint32_t> m_index;  //!< batch index
+  std::vector<double> m_mo, m_mdot, m_argpo, m_argpdot, m_nodeo, m_nodedot, m_nodecf;
+  std::vector<double> m_cc1, m_bstarCc4, m_bstarCc5, m_t2cof, m_t3cof, m_t4cof, m_t5cof;
+  std::vector<double> m_omgcof, m_eta, m_xmcof, m_delmo, m_sinmao, m_d2, m_d3, m_d4;
+  std::vector<double> m_no, m_ecco, m_inclo, m_sinio, m_cosio;
+  std::vector<double> m_aycof, m_xlcof, m_con41, m_x1mth2, m_x7thm1;
+
+  // Deep-space satellites (scalar path, each with its own record)
+  std::vector<uint32_t> m_deepSpaceIndex;         //!< batch index
+  std::vector<elsetrec> m_deepSpaceRecords;       //!< SDP4 records
+  gravconsttype m_whichconst;                     //!< gravitational constants
+};
+
+} // namespace ns3
+
+#endif /* SGP4_BATCH_PROPAGATOR_H */
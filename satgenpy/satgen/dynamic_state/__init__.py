@@ -4,3 +4,7 @@ from .helper_dynamic_state import (
 from .generate_dynamic_state import (
     generate_dynamic_state
 )
+from .convert_fstate_to_binary import (
+    convert_fstate_to_binary,
+    convert_dynamic_state_to_binary
+)
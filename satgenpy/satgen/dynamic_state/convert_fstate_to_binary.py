@@ -0,0 +1,81 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2020 ETH Zurich
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import os
+import struct
+
+FSTATE_BINARY_MAGIC = b"SATFSTAT"
+FSTATE_BINARY_VERSION = 1
+FSTATE_BINARY_VALUES_PER_RECORD = 5
+
+
+def convert_fstate_to_binary(filename_fstate_txt, filename_fstate_bin):
+    """
+    Convert a forwarding state file to the binary format read by ns-3 if satellite_network_routes_binary is set.
+
+    :param filename_fstate_txt: Filename of the forwarding state text file (typically /path/to/fstate_<t>.txt)
+                                Line format: <current node id>,<target node id>,<next hop node id>,
+                                <my if id>,<next if id>
+    :param filename_fstate_bin: Filename of the binary file to write (typically /path/to/fstate_<t>.bin)
+                                Format (little-endian): magic "SATFSTAT", version (uint32),
+                                values per record (uint32), number of records (uint64), followed by
+                                the records, each five int32 values in the same order as the text columns
+
+    :return: Number of records
+    """
+    records = []
+    with open(filename_fstate_txt, 'r') as f:
+        for line in f:
+            split = line.split(',')
+            if len(split) != FSTATE_BINARY_VALUES_PER_RECORD:
+                raise ValueError("Must have five columns: "
+                                 "<current node id>,<target node id>,<next hop node id>,<my if id>,<next if id>")
+            records.append(tuple(int(value) for value in split))
+
+    with open(filename_fstate_bin, 'wb') as f_out:
+        f_out.write(FSTATE_BINARY_MAGIC)
+        f_out.write(struct.pack("<IIQ", FSTATE_BINARY_VERSION, FSTATE_BINARY_VALUES_PER_RECORD, len(records)))
+        record_struct = struct.Struct("<5i")
+        for record in records:
+            f_out.write(record_struct.pack(*record))
+
+    return len(records)
+
+
+def convert_dynamic_state_to_binary(dynamic_state_dir):
+    """
+    Convert all forwarding state files fstate_<t>.txt in a dynamic state directory
+    to their binary counterpart fstate_<t>.bin in the same directory.
+
+    :param dynamic_state_dir: Dynamic state directory
+
+    :return: Number of files converted
+    """
+    num_files = 0
+    for filename in sorted(os.listdir(dynamic_state_dir)):
+        if filename.startswith("fstate_") and filename.endswith(".txt"):
+            convert_fstate_to_binary(
+                dynamic_state_dir + "/" + filename,
+                dynamic_state_dir + "/" + filename[:-len(".txt")] + ".bin"
+            )
+            num_files += 1
+    return num_files
@@ -0,0 +1,86 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2020 ETH Zurich
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+import satgen
+import unittest
+import struct
+import os
+
+
+class TestConvertFstateToBinary(unittest.TestCase):
+
+    def test_convert(self):
+        with open("fstate_0.txt.tmp", "w+") as f_out:
+            f_out.write("0,3,1,0,2\n")
+            f_out.write("1,3,-1,-1,-1\n")
+            f_out.write("3,2,0,0,1\n")
+        self.assertEqual(3, satgen.convert_fstate_to_binary("fstate_0.txt.tmp", "fstate_0.bin.tmp"))
+        with open("fstate_0.bin.tmp", "rb") as f_in:
+            content = f_in.read()
+        self.assertEqual(24 + 3 * 20, len(content))
+        self.assertEqual(b"SATFSTAT", content[0:8])
+        self.assertEqual((1, 5, 3), struct.unpack("<IIQ", content[8:24]))
+        self.assertEqual((0, 3, 1, 0, 2), struct.unpack("<5i", content[24:44]))
+        self.assertEqual((1, 3, -1, -1, -1), struct.unpack("<5i", content[44:64]))
+        self.assertEqual((3, 2, 0, 0, 1), struct.unpack("<5i", content[64:84]))
+        os.remove("fstate_0.txt.tmp")
+        os.remove("fstate_0.bin.tmp")
+
+    def test_convert_empty(self):
+        with open("fstate_0.txt.tmp", "w+") as f_out:
+            f_out.write("")
+        self.assertEqual(0, satgen.convert_fstate_to_binary("fstate_0.txt.tmp", "fstate_0.bin.tmp"))
+        with open("fstate_0.bin.tmp", "rb") as f_in:
+            content = f_in.read()
+        self.assertEqual(b"SATFSTAT", content[0:8])
+        self.assertEqual((1, 5, 0), struct.unpack("<IIQ", content[8:24]))
+        self.assertEqual(24, len(content))
+        os.remove("fstate_0.txt.tmp")
+        os.remove("fstate_0.bin.tmp")
+
+    def test_convert_invalid_columns(self):
+        with open("fstate_0.txt.tmp", "w+") as f_out:
+            f_out.write("0,3,1,0\n")
+        try:
+            satgen.convert_fstate_to_binary("fstate_0.txt.tmp", "fstate_0.bin.tmp")
+            self.fail()
+        except ValueError:
+            self.assertTrue(True)
+        os.remove("fstate_0.txt.tmp")
+        if os.path.exists("fstate_0.bin.tmp"):
+            os.remove("fstate_0.bin.tmp")
+
+    def test_convert_dynamic_state(self):
+        os.makedirs("dynamic_state.tmp", exist_ok=True)
+        with open("dynamic_state.tmp/fstate_0.txt", "w+") as f_out:
+            f_out.write("0,1,1,0,0\n")
+        with open("dynamic_state.tmp/fstate_100000000.txt", "w+") as f_out:
+            f_out.write("0,1,-1,-1,-1\n")
+        with open("dynamic_state.tmp/gsl_if_bandwidth_0.txt", "w+") as f_out:
+            f_out.write("0,0,1.0\n")
+        self.assertEqual(2, satgen.convert_dynamic_state_to_binary("dynamic_state.tmp"))
+        self.assertTrue(os.path.exists("dynamic_state.tmp/fstate_0.bin"))
+        self.assertTrue(os.path.exists("dynamic_state.tmp/fstate_100000000.bin"))
+        self.assertFalse(os.path.exists("dynamic_state.tmp/gsl_if_bandwidth_0.bin"))
+        for filename in os.listdir("dynamic_state.tmp"):
+            os.remove("dynamic_state.tmp/" + filename)
+        os.rmdir("dynamic_state.tmp")